@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libdsx_bench.dir/bench.cxx.o"
+  "CMakeFiles/libdsx_bench.dir/bench.cxx.o.d"
+  "libdsx_bench"
+  "libdsx_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libdsx_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
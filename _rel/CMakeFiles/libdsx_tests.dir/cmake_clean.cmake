@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libdsx_tests.dir/tests.cxx.o"
+  "CMakeFiles/libdsx_tests.dir/tests.cxx.o.d"
+  "libdsx_tests"
+  "libdsx_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libdsx_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_rel
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(libdsx_tests "/root/repo/_rel/libdsx_tests")
+set_tests_properties(libdsx_tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;35;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(libdsx_bench_smoke "/root/repo/_rel/libdsx_bench" "--samples" "1" "--warmup" "0" "--sizes" "100")
+set_tests_properties(libdsx_bench_smoke PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;43;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,241 @@
+#include <bench/harness.hpp>
+#include <bench/perf_counters.hpp>
+#include <bench/queue_suite.hpp>
+#include <bench/vector_suite.hpp>
+#include <cstdlib>
+#include <flat_map/flat_map_benchmark.hpp>
+#include <fstream>
+#include <hash_map/map_benchmark.hpp>
+#include <iostream>
+#include <queue/channel_benchmark.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <vector/vec_benchmark.hpp>
+
+namespace
+{
+void usage(const char *argv0)
+{
+    std::cerr << "usage: " << argv0
+              << " [--samples N] [--warmup N] [--sizes N,N,...] [--filter SUBSTR]\n"
+                 "       [--json OUT.json] [--baseline BASE.json] [--threshold FRACTION] [--counters on|off]\n"
+              << "       " << argv0 << " --report vector|map|flat_map|channel\n";
+}
+
+/**
+ * @brief Runs one of the standalone reports the per-structure benchmark.md
+ * files were produced with.
+ * @return The report's exit code, or -1 if there is no report by that name.
+ */
+int run_report(const std::string &name)
+{
+    if (name == "vector")
+    {
+        return vec_bench();
+    }
+    if (name == "map")
+    {
+        return map_bench();
+    }
+    if (name == "flat_map")
+    {
+        return flat_map_bench();
+    }
+    if (name == "channel")
+    {
+        return channel_bench();
+    }
+    return -1;
+}
+
+/**
+ * @brief Parses a whole command-line value as a number.
+ * @throws std::invalid_argument If the value is not a number or has trailing
+ * characters.
+ * @throws std::out_of_range If the value does not fit in T.
+ */
+template <typename T> T parse_number(const std::string &value)
+{
+    std::size_t used = 0;
+    T parsed{};
+    try
+    {
+        if constexpr (std::is_same_v<T, double>)
+        {
+            parsed = std::stod(value, &used);
+        }
+        else
+        {
+            parsed = std::stoi(value, &used);
+        }
+    }
+    catch (const std::out_of_range &)
+    {
+        throw std::out_of_range("number out of range: " + value);
+    }
+    catch (const std::invalid_argument &)
+    {
+        used = 0;
+    }
+    if (used == 0 || used != value.size())
+    {
+        throw std::invalid_argument("not a number: " + value);
+    }
+    return parsed;
+}
+
+std::vector<int> parse_sizes(const std::string &list)
+{
+    std::vector<int> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        sizes.push_back(parse_number<int>(item));
+    }
+    return sizes;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    dsx::bench::options opts;
+    std::vector<int> sizes = {1000, 100000};
+    std::string json_path;
+    std::string baseline_path;
+    double threshold = 0.10;
+    bool counters = true;
+
+    std::string report;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                usage(argv[0]);
+                return 2;
+            }
+            std::string value = argv[++i];
+
+            if (arg == "--samples")
+            {
+                opts.samples = std::max(1, parse_number<int>(value));
+            }
+            else if (arg == "--warmup")
+            {
+                opts.warmup = std::max(0, parse_number<int>(value));
+            }
+            else if (arg == "--sizes")
+            {
+                sizes = parse_sizes(value);
+            }
+            else if (arg == "--filter")
+            {
+                opts.filter = value;
+            }
+            else if (arg == "--json")
+            {
+                json_path = value;
+            }
+            else if (arg == "--baseline")
+            {
+                baseline_path = value;
+            }
+            else if (arg == "--threshold")
+            {
+                threshold = parse_number<double>(value);
+            }
+            else if (arg == "--counters")
+            {
+                counters = value != "off";
+            }
+            else if (arg == "--report")
+            {
+                report = value;
+            }
+            else
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+    }
+    catch (const std::logic_error &e)
+    {
+        // std::invalid_argument and std::out_of_range from parse_number()
+        std::cerr << "Invalid argument, " << e.what() << "\n";
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (!report.empty())
+    {
+        int status = run_report(report);
+        if (status < 0)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        return status;
+    }
+
+    dsx::bench::perf_counters perf;
+    if (counters)
+    {
+        if (perf.available())
+        {
+            opts.counters = &perf;
+        }
+        else
+        {
+            std::cerr << "Hardware counters unavailable (perf_event_open failed), timing only\n";
+        }
+    }
+
+    std::vector<dsx::bench::result> results;
+    for (int n : sizes)
+    {
+        dsx::bench::vector_suite<int>(opts, n, "int", results);
+        dsx::bench::vector_suite<double>(opts, n, "double", results);
+        dsx::bench::vector_suite<std::string>(opts, n, "string", results);
+        dsx::bench::queue_suite<int>(opts, n, "int", results);
+        dsx::bench::queue_suite<std::string>(opts, n, "string", results);
+    }
+    std::erase_if(results, [](const dsx::bench::result &res) { return res.samples == 0; });
+
+    for (const auto &res : results)
+    {
+        dsx::bench::print(std::cout, res);
+    }
+
+    if (!json_path.empty())
+    {
+        std::ofstream out(json_path);
+        dsx::bench::write_json(out, results);
+    }
+
+    if (!baseline_path.empty())
+    {
+        auto baseline = dsx::bench::read_baseline(baseline_path);
+        if (baseline.empty())
+        {
+            std::cerr << "Could not read baseline " << baseline_path << "\n";
+            return 2;
+        }
+        std::cout << "\nChange in median vs " << baseline_path << ":\n";
+        int regressions = dsx::bench::compare(std::cout, results, baseline, threshold);
+        if (regressions > 0)
+        {
+            std::cout << regressions << " benchmark(s) regressed by more than " << threshold * 100.0 << "%\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
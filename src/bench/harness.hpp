@@ -0,0 +1,270 @@
+/**
+ * @file harness.hpp
+ * @brief Micro-benchmark harness: warmup, repeated samples, percentile
+ * statistics, hardware counters, JSON output and comparison against a saved
+ * baseline.
+ */
+
+#ifndef LIBDSX_BENCH_HARNESS_H
+#define LIBDSX_BENCH_HARNESS_H
+#include "bench/perf_counters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dsx::bench
+{
+/**
+ * @brief Keeps the compiler from optimizing away a value the benchmark
+ * computed but never uses.
+ */
+template <typename T> inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Settings shared by every benchmark of a run.
+ */
+struct options
+{
+    int warmup = 2;   ///< Untimed runs before sampling.
+    int samples = 15; ///< Timed runs; statistics are taken over these.
+    std::string filter; ///< Only run benchmarks whose name contains this.
+    perf_counters *counters = nullptr; ///< Read around every sample when set and available.
+};
+
+/**
+ * @brief Statistics over the samples of one benchmark, in nanoseconds per
+ * operation.
+ */
+struct result
+{
+    std::string name;
+    int ops = 0; ///< Operations timed per sample.
+    int samples = 0;
+    double median = 0.0;
+    double mean = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    counter_values per_op = {-1, -1, -1, -1, -1, -1}; ///< Counter totals over all samples divided by the operations.
+
+    /**
+     * @brief Instructions per cycle, or -1 if either counter is missing.
+     */
+    [[nodiscard]] double ipc() const
+    {
+        double cycles = per_op[static_cast<int>(counter::cycles)];
+        double instructions = per_op[static_cast<int>(counter::instructions)];
+        return cycles > 0 && instructions >= 0 ? instructions / cycles : -1.0;
+    }
+};
+
+/**
+ * @brief Nearest-rank percentile of sorted samples.
+ */
+inline double percentile(const std::vector<double> &sorted, double pct)
+{
+    int rank = static_cast<int>(std::ceil(pct / 100.0 * sorted.size()));
+    return sorted[std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)];
+}
+
+/**
+ * @brief Runs one benchmark.
+ *
+ * Every warmup and sample run starts from a fresh default-constructed State
+ * prepared by `setup`, so runs do not leak state into each other. Only `body`
+ * is timed; setup and the State destructor are not.
+ *
+ * @param name The benchmark name, e.g. "vector/push/int/1000".
+ * @param ops The number of operations `body` performs, used to report time
+ * per operation.
+ * @param opts The run settings.
+ * @param setup Called with the fresh State before timing.
+ * @param body The timed region.
+ * @return The statistics, or a result with zero samples if filtered out.
+ */
+template <typename State, typename Setup, typename Body>
+result run(const std::string &name, int ops, const options &opts, Setup setup, Body body)
+{
+    result res;
+    res.name = name;
+    res.ops = ops;
+    if (!opts.filter.empty() && name.find(opts.filter) == std::string::npos)
+    {
+        return res;
+    }
+
+    bool counting = opts.counters && opts.counters->available();
+    counter_values totals = {};
+    std::vector<double> per_op;
+    for (int i = 0; i < opts.warmup + opts.samples; i++)
+    {
+        State state;
+        setup(state);
+        if (counting)
+        {
+            opts.counters->start();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body(state);
+        auto end = std::chrono::steady_clock::now();
+        counter_values sample_counts = counting ? opts.counters->stop() : counter_values{};
+        do_not_optimize(state);
+
+        if (i >= opts.warmup)
+        {
+            per_op.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+            for (int c = 0; c < counter_count; c++)
+            {
+                totals[c] = (totals[c] < 0 || sample_counts[c] < 0) ? -1.0 : totals[c] + sample_counts[c];
+            }
+        }
+    }
+
+    std::sort(per_op.begin(), per_op.end());
+    res.samples = static_cast<int>(per_op.size());
+    res.median = percentile(per_op, 50);
+    res.p90 = percentile(per_op, 90);
+    res.p99 = percentile(per_op, 99);
+    res.min = per_op.front();
+    res.max = per_op.back();
+    for (double sample : per_op)
+    {
+        res.mean += sample / per_op.size();
+    }
+    if (counting)
+    {
+        for (int c = 0; c < counter_count; c++)
+        {
+            res.per_op[c] = totals[c] < 0 ? -1.0 : totals[c] / (static_cast<double>(ops) * res.samples);
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Prints one result as a human-readable table row.
+ */
+inline void print(std::ostream &out, const result &res)
+{
+    out << std::left << std::setw(48) << res.name << std::right << std::fixed << std::setprecision(2)
+        << " median " << std::setw(10) << res.median << " ns/op  p90 " << std::setw(10) << res.p90 << "  p99 "
+        << std::setw(10) << res.p99 << "  (" << res.samples << " x " << res.ops << " ops)\n";
+
+    if (res.ipc() < 0 && res.per_op[static_cast<int>(counter::l1d_misses)] < 0)
+    {
+        return; // No counters for this run
+    }
+    out << std::setw(48) << "" << std::setprecision(3) << " ipc " << res.ipc();
+    for (counter c : {counter::cycles, counter::l1d_misses, counter::llc_misses, counter::branch_misses,
+                      counter::dtlb_misses})
+    {
+        double value = res.per_op[static_cast<int>(c)];
+        if (value >= 0)
+        {
+            out << "  " << counter_name(c) << "/op " << value;
+        }
+    }
+    out << "\n";
+}
+
+/**
+ * @brief Writes results as JSON, one benchmark object per line so that
+ * read_baseline() can read it back without a full JSON parser.
+ */
+inline void write_json(std::ostream &out, const std::vector<result> &results)
+{
+    out << "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const result &res = results[i];
+        out << "    {\"name\": \"" << res.name << "\", \"ops\": " << res.ops << ", \"samples\": " << res.samples
+            << std::setprecision(4) << std::fixed << ", \"median\": " << res.median << ", \"mean\": " << res.mean
+            << ", \"p90\": " << res.p90 << ", \"p99\": " << res.p99 << ", \"min\": " << res.min
+            << ", \"max\": " << res.max << ", \"ipc\": " << res.ipc();
+        for (int c = 0; c < counter_count; c++)
+        {
+            // Missing counters are reported as -1 like ipc, keeping every line the same shape
+            out << ", \"" << counter_name(static_cast<counter>(c)) << "_per_op\": " << res.per_op[c];
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief Reads the medians out of a file written by write_json().
+ *
+ * @param path The baseline file.
+ * @return Median ns/op by benchmark name; empty if the file cannot be read.
+ */
+inline std::map<std::string, double> read_baseline(const std::string &path)
+{
+    std::map<std::string, double> medians;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        auto name_at = line.find("\"name\": \"");
+        auto median_at = line.find("\"median\": ");
+        if (name_at == std::string::npos || median_at == std::string::npos)
+        {
+            continue;
+        }
+        name_at += 9;
+        std::string name = line.substr(name_at, line.find('"', name_at) - name_at);
+        medians[name] = std::stod(line.substr(median_at + 10));
+    }
+    return medians;
+}
+
+/**
+ * @brief Compares medians against a baseline and reports regressions.
+ *
+ * @param out Where the comparison table is printed.
+ * @param results The current run.
+ * @param baseline Medians from read_baseline().
+ * @param threshold Relative slowdown tolerated, e.g. 0.10 for 10%.
+ * @return The number of benchmarks slower than the baseline by more than the
+ * threshold.
+ */
+inline int compare(std::ostream &out, const std::vector<result> &results,
+                   const std::map<std::string, double> &baseline, double threshold)
+{
+    int regressions = 0;
+    for (const result &res : results)
+    {
+        auto it = baseline.find(res.name);
+        if (it == baseline.end() || it->second <= 0.0)
+        {
+            continue;
+        }
+
+        double delta = (res.median - it->second) / it->second;
+        bool regressed = delta > threshold;
+        regressions += regressed;
+        out << std::left << std::setw(48) << res.name << std::right << std::fixed << std::setprecision(1)
+            << std::showpos << std::setw(8) << delta * 100.0 << std::noshowpos << "%"
+            << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+    return regressions;
+}
+
+} // namespace dsx::bench
+
+#endif // LIBDSX_BENCH_HARNESS_H
@@ -0,0 +1,211 @@
+/**
+ * @file perf_counters.hpp
+ * @brief Hardware performance counters around a measured region, read through
+ * Linux perf_event_open.
+ */
+
+#ifndef LIBDSX_BENCH_PERF_COUNTERS_H
+#define LIBDSX_BENCH_PERF_COUNTERS_H
+#include <array>
+#include <cstdint>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dsx::bench
+{
+/**
+ * @brief The counters read around each measured region.
+ */
+enum class counter
+{
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    dtlb_misses,
+};
+
+inline constexpr int counter_count = 6;
+
+inline const char *counter_name(counter c)
+{
+    switch (c)
+    {
+    case counter::cycles:
+        return "cycles";
+    case counter::instructions:
+        return "instructions";
+    case counter::l1d_misses:
+        return "l1d_misses";
+    case counter::llc_misses:
+        return "llc_misses";
+    case counter::branch_misses:
+        return "branch_misses";
+    case counter::dtlb_misses:
+        return "dtlb_misses";
+    }
+    return "";
+}
+
+/**
+ * @brief Counter totals of one region. A counter that could not be opened
+ * reads as -1.
+ */
+using counter_values = std::array<double, counter_count>;
+
+/**
+ * @brief A set of hardware counters for the calling thread.
+ *
+ * The counters are opened as one group led by the first event that opens, so
+ * the PMU schedules them together and every ratio (IPC, misses per
+ * instruction) is taken over the same instructions. An event the kernel or VM
+ * lacks, or that does not fit in the group next to the others, fails to open
+ * and is simply left out. Values are scaled by time_enabled / time_running in
+ * case the group was multiplexed; a group that never got on the PMU reads -1.
+ * When perf_event_open is unavailable (non-Linux, perf_event_paranoid too
+ * high, no PMU in a container) every counter reads -1 and the benchmarks run
+ * as before.
+ */
+class perf_counters
+{
+  private:
+    std::array<int, counter_count> _fds;
+    int _leader = -1; ///< File descriptor of the group leader, -1 if nothing opened.
+
+  public:
+    perf_counters()
+    {
+        _fds.fill(-1);
+#if defined(__linux__)
+        const std::uint64_t cache_read_miss =
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        open(counter::cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open(counter::instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open(counter::l1d_misses, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_read_miss);
+        open(counter::llc_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open(counter::branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open(counter::dtlb_misses, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cache_read_miss);
+#endif
+    }
+
+    perf_counters(const perf_counters &) = delete;
+    perf_counters &operator=(const perf_counters &) = delete;
+
+    ~perf_counters()
+    {
+#if defined(__linux__)
+        for (int fd : _fds)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Check if at least one counter could be opened.
+     */
+    [[nodiscard]] bool available() const
+    {
+        for (int fd : _fds)
+        {
+            if (fd >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check if a specific counter could be opened.
+     */
+    [[nodiscard]] bool available(counter c) const
+    {
+        return _fds[static_cast<int>(c)] >= 0;
+    }
+
+    /**
+     * @brief Resets and starts every open counter at once.
+     */
+    void start()
+    {
+#if defined(__linux__)
+        if (_leader >= 0)
+        {
+            ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops every open counter and returns the totals since start().
+     */
+    counter_values stop()
+    {
+        counter_values values;
+        values.fill(-1.0);
+#if defined(__linux__)
+        if (_leader < 0)
+        {
+            return values;
+        }
+        ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // nr, time_enabled, time_running, then one value per member in the
+        // order they joined the group
+        std::uint64_t data[3 + counter_count];
+        ssize_t got = read(_leader, data, sizeof(data));
+        if (got < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) || data[2] == 0)
+        {
+            return values; // Never scheduled: unavailable, not zero
+        }
+
+        std::uint64_t member = 0;
+        for (int i = 0; i < counter_count && member < data[0]; i++)
+        {
+            if (_fds[i] >= 0)
+            {
+                values[i] = static_cast<double>(data[3 + member++]) * data[1] / data[2];
+            }
+        }
+#endif
+        return values;
+    }
+
+  private:
+#if defined(__linux__)
+    void open(counter c, std::uint32_t type, std::uint64_t config)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = _leader < 0; // Members follow the leader's enable state
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, _leader, 0);
+        _fds[static_cast<int>(c)] = static_cast<int>(fd);
+        if (fd >= 0 && _leader < 0)
+        {
+            _leader = static_cast<int>(fd);
+        }
+    }
+#endif
+};
+
+} // namespace dsx::bench
+
+#endif // LIBDSX_BENCH_PERF_COUNTERS_H
@@ -0,0 +1,87 @@
+/**
+ * @file queue_suite.hpp
+ * @brief Benchmarks for Queue against std::queue and std::stack.
+ */
+
+#ifndef LIBDSX_BENCH_QUEUE_SUITE_H
+#define LIBDSX_BENCH_QUEUE_SUITE_H
+#include "bench/harness.hpp"
+#include "bench/vector_suite.hpp"
+#include "queue/queue.hpp"
+#include <queue>
+#include <stack>
+#include <string>
+#include <vector>
+
+namespace dsx::bench
+{
+template <typename T> struct dsx_queue_state
+{
+    Queue<T> queue;
+};
+
+template <typename T> struct std_queue_state
+{
+    std::queue<T> queue;
+};
+
+template <typename T> struct std_stack_state
+{
+    std::stack<T> stack;
+};
+
+/**
+ * @brief Runs every queue benchmark for one element type and size.
+ *
+ * Queue::dequeue() removes the most recently enqueued element, so it is timed
+ * against std::stack::pop() rather than the FIFO std::queue::pop().
+ */
+template <typename T>
+void queue_suite(const options &opts, int n, const std::string &type, std::vector<result> &out)
+{
+    using dsx_state = dsx_queue_state<T>;
+    using std_state = std_queue_state<T>;
+    using stack_state = std_stack_state<T>;
+    const std::string suffix = "/" + type + "/" + std::to_string(n);
+
+    auto fill_dsx = [n](dsx_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            s.queue.enqueue(make_value<T>(i));
+        }
+    };
+    auto fill_std = [n](std_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            s.queue.push(make_value<T>(i));
+        }
+    };
+    auto fill_stack = [n](stack_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            s.stack.push(make_value<T>(i));
+        }
+    };
+    auto nothing = [](auto &) {};
+
+    out.push_back(run<dsx_state>("queue/enqueue" + suffix, n, opts, nothing, fill_dsx));
+    out.push_back(run<std_state>("std::queue/push" + suffix, n, opts, nothing, fill_std));
+
+    out.push_back(run<dsx_state>("queue/dequeue_lifo" + suffix, n, opts, fill_dsx, [n](dsx_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            do_not_optimize(s.queue.dequeue());
+        }
+    }));
+    out.push_back(run<stack_state>("std::stack/pop" + suffix, n, opts, fill_stack, [n](stack_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            do_not_optimize(s.stack.top());
+            s.stack.pop();
+        }
+    }));
+}
+
+} // namespace dsx::bench
+
+#endif // LIBDSX_BENCH_QUEUE_SUITE_H
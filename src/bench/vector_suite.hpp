@@ -0,0 +1,142 @@
+/**
+ * @file vector_suite.hpp
+ * @brief Benchmarks for dsx::structs::vector against std::vector.
+ *
+ * Both containers always start from the same state: either default
+ * constructed and growing, or explicitly reserve()d, never one of each.
+ */
+
+#ifndef LIBDSX_BENCH_VECTOR_SUITE_H
+#define LIBDSX_BENCH_VECTOR_SUITE_H
+#include "bench/harness.hpp"
+#include "vector/vector.hpp"
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dsx::bench
+{
+/**
+ * @brief Deterministic element for index i.
+ */
+template <typename T> inline T make_value(int i)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return "value-" + std::to_string(i);
+    }
+    else
+    {
+        return static_cast<T>(i);
+    }
+}
+
+template <typename T> struct dsx_vector_state
+{
+    dsx::structs::vector<T> vec;
+};
+
+template <typename T> struct std_vector_state
+{
+    std::vector<T> vec;
+};
+
+/**
+ * @brief Runs every vector benchmark for one element type and size.
+ *
+ * insert_at/erase_at at the front are O(n) each, so they perform at most 1000
+ * operations on a vector already holding n elements.
+ */
+template <typename T>
+void vector_suite(const options &opts, int n, const std::string &type, std::vector<result> &out)
+{
+    using dsx_state = dsx_vector_state<T>;
+    using std_state = std_vector_state<T>;
+    const std::string suffix = "/" + type + "/" + std::to_string(n);
+    const int shifts = std::min(n, 1000);
+
+    auto fill_dsx = [n](dsx_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            s.vec.push(make_value<T>(i));
+        }
+    };
+    auto fill_std = [n](std_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            s.vec.push_back(make_value<T>(i));
+        }
+    };
+    auto nothing = [](auto &) {};
+
+    out.push_back(run<dsx_state>("vector/push" + suffix, n, opts, nothing, fill_dsx));
+    out.push_back(run<std_state>("std::vector/push_back" + suffix, n, opts, nothing, fill_std));
+
+    out.push_back(run<dsx_state>(
+        "vector/push_reserved" + suffix, n, opts, [n](dsx_state &s) { s.vec.reserve(n + 1); }, fill_dsx));
+    out.push_back(run<std_state>(
+        "std::vector/push_back_reserved" + suffix, n, opts, [n](std_state &s) { s.vec.reserve(n + 1); }, fill_std));
+
+    out.push_back(run<dsx_state>("vector/pop" + suffix, n, opts, fill_dsx, [n](dsx_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            do_not_optimize(s.vec.pop());
+        }
+    }));
+    out.push_back(run<std_state>("std::vector/pop_back" + suffix, n, opts, fill_std, [n](std_state &s) {
+        for (int i = 0; i < n; i++)
+        {
+            do_not_optimize(s.vec.back());
+            s.vec.pop_back();
+        }
+    }));
+
+    out.push_back(run<dsx_state>("vector/insert_at_front" + suffix, shifts, opts, fill_dsx, [shifts](dsx_state &s) {
+        for (int i = 0; i < shifts; i++)
+        {
+            s.vec.insert_at(make_value<T>(i), 0);
+        }
+    }));
+    out.push_back(run<std_state>("std::vector/insert_front" + suffix, shifts, opts, fill_std, [shifts](std_state &s) {
+        for (int i = 0; i < shifts; i++)
+        {
+            s.vec.insert(s.vec.begin(), make_value<T>(i));
+        }
+    }));
+
+    out.push_back(run<dsx_state>("vector/erase_at_front" + suffix, shifts, opts, fill_dsx, [shifts](dsx_state &s) {
+        for (int i = 0; i < shifts; i++)
+        {
+            do_not_optimize(s.vec.erase_at(0));
+        }
+    }));
+    out.push_back(run<std_state>("std::vector/erase_front" + suffix, shifts, opts, fill_std, [shifts](std_state &s) {
+        for (int i = 0; i < shifts; i++)
+        {
+            s.vec.erase(s.vec.begin());
+        }
+    }));
+
+    // Single reallocation of n elements into twice the room
+    out.push_back(run<dsx_state>("vector/reserve" + suffix, 1, opts, fill_dsx,
+                                 [n](dsx_state &s) { s.vec.reserve(s.vec.capacity() + 2 * n); }));
+    out.push_back(run<std_state>("std::vector/reserve" + suffix, 1, opts, fill_std,
+                                 [n](std_state &s) { s.vec.reserve(s.vec.capacity() + 2 * n); }));
+
+    auto fill_dsx_slack = [&](dsx_state &s) {
+        fill_dsx(s);
+        s.vec.reserve(s.vec.capacity() + 2 * n);
+    };
+    auto fill_std_slack = [&](std_state &s) {
+        fill_std(s);
+        s.vec.reserve(s.vec.capacity() + 2 * n);
+    };
+    out.push_back(run<dsx_state>("vector/shrink" + suffix, 1, opts, fill_dsx_slack, [](dsx_state &s) { s.vec.shrink(); }));
+    out.push_back(run<std_state>("std::vector/shrink_to_fit" + suffix, 1, opts, fill_std_slack,
+                                 [](std_state &s) { s.vec.shrink_to_fit(); }));
+}
+
+} // namespace dsx::bench
+
+#endif // LIBDSX_BENCH_VECTOR_SUITE_H
@@ -0,0 +1,577 @@
+/**
+ * @file flat_map.hpp
+ * @brief Definition of the flat_map and flat_set adaptors, sorted associative
+ * containers stored in dsx::structs::vector, and of their search policies.
+ */
+
+#ifndef LIBDSX_FLAT_MAP_H
+#define LIBDSX_FLAT_MAP_H
+#include "vector/vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace dsx::structs
+{
+/**
+ * @brief Search policy: branchless lower bound directly on the sorted keys.
+ *
+ * Needs no extra memory. The loop halves the range with a conditional move
+ * instead of a branch, so its cost does not depend on how predictable the
+ * comparisons are.
+ */
+template <typename K> struct binary_search_policy
+{
+    void rebuild(const K *, int)
+    {
+    }
+
+    template <typename Q, typename Compare> int lower_bound(const K *keys, int n, const Q &key, Compare comp) const
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        // The answer always lies in [base, base + n]
+        const K *base = keys;
+        while (n > 1)
+        {
+            int half = n / 2;
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - keys) + comp(*base, key);
+    }
+
+    template <typename Q, typename Compare> int find(const K *keys, int n, const Q &key, Compare comp) const
+    {
+        int idx = lower_bound(keys, n, key, comp);
+        return idx == n || comp(key, keys[idx]) ? -1 : idx;
+    }
+};
+
+/**
+ * @brief Search policy: branchless search on an Eytzinger (BFS-order) copy of
+ * the keys.
+ *
+ * The first levels of the implicit tree share a handful of cache lines and
+ * the children of a node sit next to each other, so the next levels can be
+ * prefetched while the current comparison is in flight. Each node stores its
+ * sorted index next to the key, so a hit reads the tree and then the value,
+ * with no third lookup in between. Costs a second copy of the keys plus an int
+ * per key, rebuilt in O(n) after every modification.
+ *
+ * Only pays off once the keys outgrow the cache; for smaller maps the binary
+ * policy is as fast or faster.
+ */
+template <typename K> struct eytzinger_search_policy
+{
+    struct node
+    {
+        K key;
+        int rank; ///< Index of the key in the sorted array.
+    };
+
+    dsx::structs::vector<node> _tree = dsx::structs::vector<node>(1); ///< 1-indexed, slot 0 unused.
+
+    void rebuild(const K *keys, int n)
+    {
+        _tree.resize(n + 1);
+        int next = 0;
+        fill(keys, n, next, 1);
+    }
+
+    template <typename Q, typename Compare> int lower_bound(const K *, int n, const Q &key, Compare comp) const
+    {
+        unsigned k = descend(n, key, comp);
+        return k == 0 ? n : _tree.data()[k].rank;
+    }
+
+    template <typename Q, typename Compare> int find(const K *, int n, const Q &key, Compare comp) const
+    {
+        // The node holding the lower bound is already in cache, rank included
+        unsigned k = descend(n, key, comp);
+        const node &hit = _tree.data()[k];
+        return k == 0 || comp(key, hit.key) ? -1 : hit.rank;
+    }
+
+  private:
+    /**
+     * @brief Returns the tree position of the lower bound, or 0 if every key
+     * is smaller.
+     */
+    template <typename Q, typename Compare> unsigned descend(int n, const Q &key, Compare comp) const
+    {
+        constexpr unsigned per_line = std::max<unsigned>(64 / sizeof(node), 1);
+        const node *tree = _tree.data();
+        unsigned k = 1;
+        while (k <= static_cast<unsigned>(n))
+        {
+#if defined(__GNUC__)
+            __builtin_prefetch(tree + per_line * k); // The cache line holding the descendants a few levels down
+#endif
+            k = 2 * k + comp(tree[k].key, key);
+        }
+        // Undo the trailing right turns plus the last left turn
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    void fill(const K *keys, int n, int &next, int k)
+    {
+        if (k > n)
+        {
+            return;
+        }
+        fill(keys, n, next, 2 * k);
+        _tree.data()[k] = node{keys[next], next};
+        next++;
+        fill(keys, n, next, 2 * k + 1);
+    }
+};
+
+/**
+ * @brief A sorted map stored as two parallel dsx::structs::vector, one for the
+ * keys and one for the values.
+ *
+ * Lookups only touch the dense key array, which makes them much more cache
+ * friendly than a node-based tree map. Single insertions and erasures shift
+ * elements (O(n)); for batch rebuilds, insert_bulk() sorts the batch once and
+ * merges it with the existing entries in a single pass.
+ *
+ * @tparam K The key type. Must be default constructible.
+ * @tparam V The mapped type. Must be default constructible.
+ * @tparam Compare The key ordering. The default std::less<> also enables
+ * heterogeneous lookup.
+ * @tparam Search The search policy, binary_search_policy or
+ * eytzinger_search_policy.
+ */
+template <typename K, typename V, typename Compare = std::less<>, typename Search = binary_search_policy<K>>
+class flat_map
+{
+  private:
+    dsx::structs::vector<K> _keys = dsx::structs::vector<K>(0);
+    dsx::structs::vector<V> _values = dsx::structs::vector<V>(0);
+    Compare _comp;
+    Search _search;
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty map.
+     */
+    flat_map() = default;
+
+    /**
+     * @brief Constructor that bulk-builds the map from key/value pairs.
+     * @param list The entries; for duplicate keys the last one wins.
+     */
+    flat_map(std::initializer_list<std::pair<K, V>> list)
+    {
+        insert_bulk(list.begin(), list.end());
+    }
+
+    flat_map(const flat_map &) = delete;
+    flat_map &operator=(const flat_map &) = delete;
+
+  public:
+    /**
+     * @brief Get the number of entries in the map.
+     * @return The number of entries in the map.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _keys.len();
+    }
+
+    /**
+     * @brief Check if the map is empty.
+     * @return True if the map is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    /**
+     * @brief Reserves memory for a given number of entries.
+     * @param n_size The number of entries to reserve memory for.
+     */
+    void reserve(int n_size)
+    {
+        _keys.reserve(n_size);
+        _values.reserve(n_size);
+    }
+
+    /**
+     * @brief Removes all entries from the map.
+     */
+    void clear()
+    {
+        _keys.clear();
+        _values.clear();
+        _search.rebuild(_keys.data(), 0);
+    }
+
+  public:
+    /**
+     * @brief Returns the i-th smallest key.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    const K &key_at(int p_idx) const
+    {
+        return _keys[p_idx];
+    }
+
+    /**
+     * @brief Returns the value mapped to the i-th smallest key.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    V &value_at(int p_idx) const
+    {
+        return _values[p_idx];
+    }
+
+    /**
+     * @brief Returns the index of the first key not less than `key`.
+     * @return An index in [0, len()].
+     */
+    template <typename Q> int lower_bound(const Q &key) const
+    {
+        return _search.lower_bound(_keys.data(), len(), key, _comp);
+    }
+
+    /**
+     * @brief Looks up a key.
+     *
+     * @param key The key to look for, or any type comparable to it.
+     * @return A pointer to the mapped value, or nullptr if the key is absent.
+     * The pointer is invalidated by the next modification.
+     */
+    template <typename Q> V *find(const Q &key) const
+    {
+        int idx = _search.find(_keys.data(), len(), key, _comp);
+        return idx < 0 ? nullptr : &_values.data()[idx];
+    }
+
+    /**
+     * @brief Checks if the map contains a key.
+     */
+    template <typename Q> [[nodiscard]] bool contains(const Q &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Returns the value mapped to a key.
+     *
+     * @throws std::out_of_range If the key is absent.
+     */
+    template <typename Q> V at(const Q &key) const
+    {
+        V *value = find(key);
+        if (!value)
+        {
+            throw std::out_of_range("flat_map::at: key not found");
+        }
+        return *value;
+    }
+
+  public:
+    bool insert(const K &key, const V &value);
+    template <typename Q> std::optional<V> erase(const Q &key);
+    template <typename It> void insert_bulk(It first, It last);
+};
+
+/**
+ * @brief A sorted set stored in a dsx::structs::vector.
+ *
+ * Same layout and search policies as flat_map, without the values.
+ *
+ * @tparam K The key type. Must be default constructible.
+ * @tparam Compare The key ordering.
+ * @tparam Search The search policy.
+ */
+template <typename K, typename Compare = std::less<>, typename Search = binary_search_policy<K>> class flat_set
+{
+  private:
+    dsx::structs::vector<K> _keys = dsx::structs::vector<K>(0);
+    Compare _comp;
+    Search _search;
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty set.
+     */
+    flat_set() = default;
+
+    /**
+     * @brief Constructor that bulk-builds the set.
+     * @param list The keys; duplicates are dropped.
+     */
+    flat_set(std::initializer_list<K> list)
+    {
+        insert_bulk(list.begin(), list.end());
+    }
+
+    flat_set(const flat_set &) = delete;
+    flat_set &operator=(const flat_set &) = delete;
+
+  public:
+    /**
+     * @brief Get the number of keys in the set.
+     * @return The number of keys in the set.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _keys.len();
+    }
+
+    /**
+     * @brief Check if the set is empty.
+     * @return True if the set is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    /**
+     * @brief Reserves memory for a given number of keys.
+     * @param n_size The number of keys to reserve memory for.
+     */
+    void reserve(int n_size)
+    {
+        _keys.reserve(n_size);
+    }
+
+    /**
+     * @brief Removes all keys from the set.
+     */
+    void clear()
+    {
+        _keys.clear();
+        _search.rebuild(_keys.data(), 0);
+    }
+
+    /**
+     * @brief Returns the i-th smallest key.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    const K &key_at(int p_idx) const
+    {
+        return _keys[p_idx];
+    }
+
+    /**
+     * @brief Returns the index of the first key not less than `key`.
+     * @return An index in [0, len()].
+     */
+    template <typename Q> int lower_bound(const Q &key) const
+    {
+        return _search.lower_bound(_keys.data(), len(), key, _comp);
+    }
+
+    /**
+     * @brief Checks if the set contains a key.
+     */
+    template <typename Q> [[nodiscard]] bool contains(const Q &key) const
+    {
+        return _search.find(_keys.data(), len(), key, _comp) >= 0;
+    }
+
+  public:
+    bool insert(const K &key);
+    template <typename Q> bool erase(const Q &key);
+    template <typename It> void insert_bulk(It first, It last);
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Inserts an entry, or overwrites the value if the key is present.
+ *
+ * O(n) because of the shift; prefer insert_bulk() for batches.
+ *
+ * @return True if the key was new, false if an existing value was replaced.
+ */
+template <typename K, typename V, typename Compare, typename Search>
+bool dsx::structs::flat_map<K, V, Compare, Search>::insert(const K &key, const V &value)
+{
+    int idx = lower_bound(key);
+    if (idx < len() && !_comp(key, _keys.data()[idx]))
+    {
+        _values.data()[idx] = value;
+        return false;
+    }
+
+    _keys.insert_at(key, idx);
+    _values.insert_at(value, idx);
+    _search.rebuild(_keys.data(), len());
+    return true;
+}
+
+/**
+ * @brief Removes a key and returns its mapped value.
+ *
+ * @return An optional containing the removed value, or an empty optional if
+ * the key was absent.
+ */
+template <typename K, typename V, typename Compare, typename Search>
+template <typename Q>
+std::optional<V> dsx::structs::flat_map<K, V, Compare, Search>::erase(const Q &key)
+{
+    int idx = _search.find(_keys.data(), len(), key, _comp);
+    if (idx < 0)
+    {
+        return std::nullopt;
+    }
+
+    _keys.erase_at(idx);
+    auto erased_value = _values.erase_at(idx);
+    _search.rebuild(_keys.data(), len());
+    return erased_value;
+}
+
+/**
+ * @brief Inserts a batch of key/value pairs with one sort and one merge.
+ *
+ * The batch is stable-sorted by key and merged with the existing entries into
+ * fresh arrays, so the cost is O(m log m + n) instead of m O(n) insertions.
+ * When a key appears several times the last occurrence wins, including over
+ * a value already in the map.
+ *
+ * @param first, last A range of std::pair<K, V> (or anything with .first and
+ * .second).
+ */
+template <typename K, typename V, typename Compare, typename Search>
+template <typename It>
+void dsx::structs::flat_map<K, V, Compare, Search>::insert_bulk(It first, It last)
+{
+    dsx::structs::vector<std::pair<K, V>> batch(static_cast<int>(std::distance(first, last)) + 1);
+    for (; first != last; ++first)
+    {
+        batch.push({first->first, first->second});
+    }
+
+    std::pair<K, V> *in = batch.data();
+    int m = batch.len();
+    std::stable_sort(in, in + m, [this](const auto &a, const auto &b) { return _comp(a.first, b.first); });
+
+    int n = len();
+    dsx::structs::vector<K> n_keys(n + m);
+    dsx::structs::vector<V> n_values(n + m);
+    n_keys.resize(n + m);
+    n_values.resize(n + m);
+
+    const K *keys = _keys.data();
+    const V *values = _values.data();
+    K *out_keys = n_keys.data();
+    V *out_values = n_values.data();
+    int i = 0, j = 0, out = 0;
+    while (i < n || j < m)
+    {
+        if (j < m && j + 1 < m && !_comp(in[j].first, in[j + 1].first))
+        {
+            ++j; // A later duplicate in the batch overrides this one
+            continue;
+        }
+
+        if (j == m || (i < n && _comp(keys[i], in[j].first)))
+        {
+            out_keys[out] = keys[i];
+            out_values[out++] = values[i++];
+        }
+        else
+        {
+            if (i < n && !_comp(in[j].first, keys[i]))
+            {
+                ++i; // Replaced by the batch entry
+            }
+            out_keys[out] = in[j].first;
+            out_values[out++] = in[j++].second;
+        }
+    }
+
+    n_keys.resize(out);
+    n_values.resize(out);
+    _keys.swap(n_keys);
+    _values.swap(n_values);
+    _search.rebuild(_keys.data(), len());
+}
+
+/**
+ * @brief Inserts a key if it is absent. O(n) because of the shift.
+ *
+ * @return True if the key was inserted.
+ */
+template <typename K, typename Compare, typename Search>
+bool dsx::structs::flat_set<K, Compare, Search>::insert(const K &key)
+{
+    int idx = lower_bound(key);
+    if (idx < len() && !_comp(key, _keys.data()[idx]))
+    {
+        return false;
+    }
+
+    _keys.insert_at(key, idx);
+    _search.rebuild(_keys.data(), len());
+    return true;
+}
+
+/**
+ * @brief Removes a key.
+ *
+ * @return True if the key was present.
+ */
+template <typename K, typename Compare, typename Search>
+template <typename Q>
+bool dsx::structs::flat_set<K, Compare, Search>::erase(const Q &key)
+{
+    int idx = _search.find(_keys.data(), len(), key, _comp);
+    if (idx < 0)
+    {
+        return false;
+    }
+
+    _keys.erase_at(idx);
+    _search.rebuild(_keys.data(), len());
+    return true;
+}
+
+/**
+ * @brief Inserts a batch of keys with one sort and one merge.
+ *
+ * @param first, last A range of keys; duplicates are dropped.
+ */
+template <typename K, typename Compare, typename Search>
+template <typename It>
+void dsx::structs::flat_set<K, Compare, Search>::insert_bulk(It first, It last)
+{
+    dsx::structs::vector<K> batch(static_cast<int>(std::distance(first, last)) + 1);
+    for (; first != last; ++first)
+    {
+        batch.push(*first);
+    }
+
+    K *in = batch.data();
+    int m = batch.len();
+    std::sort(in, in + m, _comp);
+    m = static_cast<int>(std::unique(in, in + m, [this](const K &a, const K &b) { return !_comp(a, b); }) - in);
+
+    int n = len();
+    dsx::structs::vector<K> n_keys(n + m);
+    n_keys.resize(n + m);
+
+    const K *keys = _keys.data();
+    K *out_end = std::set_union(keys, keys + n, in, in + m, n_keys.data(), _comp);
+
+    n_keys.resize(static_cast<int>(out_end - n_keys.data()));
+    _keys.swap(n_keys);
+    _search.rebuild(_keys.data(), len());
+}
+
+#endif // LIBDSX_FLAT_MAP_H
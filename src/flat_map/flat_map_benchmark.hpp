@@ -0,0 +1,91 @@
+#include "flat_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Nanoseconds per lookup of every key in shuffled order, reading the value
+// on a hit.
+template <typename Lookup>
+double benchmarkLookups(const std::vector<int> &queries, Lookup lookup) {
+  long long found = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : queries) {
+    found += lookup(key);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (found != static_cast<long long>(queries.size())) {
+    std::cerr << "Flat map benchmark lookup mismatch\n";
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         static_cast<double>(queries.size());
+}
+
+template <typename Build> double benchmarkBuild(Build build) {
+  auto start = std::chrono::high_resolution_clock::now();
+  build();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+inline int flat_map_bench(int max_exponent = 6) {
+  std::cout << "Benchmarking flat_map vs std::map:\n";
+  std::cout << "------------------------\n";
+
+  for (int e = 3; e <= max_exponent; e++) {
+    int count = static_cast<int>(pow(10, e));
+    std::vector<std::pair<int, int>> entries;
+    for (int i = 0; i < count; ++i) {
+      entries.push_back({i * 2, i});
+    }
+    std::mt19937 rng(42);
+    std::shuffle(entries.begin(), entries.end(), rng);
+    std::vector<int> queries;
+    for (const auto &entry : entries) {
+      queries.push_back(entry.first);
+    }
+    std::shuffle(queries.begin(), queries.end(), rng);
+
+    dsx::structs::flat_map<int, int> binary_map;
+    dsx::structs::flat_map<int, int, std::less<>,
+                           dsx::structs::eytzinger_search_policy<int>>
+        eytzinger_map;
+    std::map<int, int> std_map;
+
+    double binary_build = benchmarkBuild(
+        [&] { binary_map.insert_bulk(entries.begin(), entries.end()); });
+    double eytzinger_build = benchmarkBuild(
+        [&] { eytzinger_map.insert_bulk(entries.begin(), entries.end()); });
+    double std_build = benchmarkBuild(
+        [&] { std_map.insert(entries.begin(), entries.end()); });
+
+    double binary_lookup = benchmarkLookups(
+        queries, [&](int key) {
+          int *value = binary_map.find(key);
+          return value != nullptr && *value >= 0;
+        });
+    double eytzinger_lookup = benchmarkLookups(
+        queries, [&](int key) {
+          int *value = eytzinger_map.find(key);
+          return value != nullptr && *value >= 0;
+        });
+    double std_lookup = benchmarkLookups(
+        queries, [&](int key) { return std_map.find(key) != std_map.end(); });
+
+    std::cout << "Keys: " << count << std::endl;
+    std::cout << "flat_map (binary) build: " << binary_build
+              << " ms, lookup: " << binary_lookup << " ns\n";
+    std::cout << "flat_map (eytzinger) build: " << eytzinger_build
+              << " ms, lookup: " << eytzinger_lookup << " ns\n";
+    std::cout << "std::map build: " << std_build
+              << " ms, lookup: " << std_lookup << " ns\n";
+    std::cout << "---------------------------------\n";
+  }
+
+  return 0;
+}
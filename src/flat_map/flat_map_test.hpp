@@ -0,0 +1,91 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flat_map.hpp"
+
+// Helper macro for test assertions
+#ifndef ASSERT
+#define ASSERT(condition)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::cerr << "Assertion failed at line " << __LINE__ << " in function " << __FUNCTION__ << ": "            \
+                      << #condition << std::endl;                                                                      \
+            exit(-1);                                                                                                  \
+        }                                                                                                              \
+    } while (0)
+#endif
+
+template <typename Search> inline void flat_map_search_test()
+{
+    // Single insertions keep the keys sorted
+    dsx::structs::flat_map<int, std::string, std::less<>, Search> m1;
+    ASSERT(m1.is_empty() && m1.find(1) == nullptr);
+    ASSERT(m1.insert(3, "three") && m1.insert(1, "one") && m1.insert(2, "two"));
+    ASSERT(!m1.insert(2, "TWO") && m1.at(2) == "TWO");
+    ASSERT(m1.len() == 3 && m1.key_at(0) == 1 && m1.key_at(2) == 3);
+    ASSERT(m1.lower_bound(0) == 0 && m1.lower_bound(4) == 3);
+    ASSERT(m1.erase(1).value() == "one" && !m1.erase(1).has_value());
+    ASSERT(!m1.contains(1) && m1.contains(3));
+
+    // Bulk build merges with existing entries, last duplicate wins
+    dsx::structs::flat_map<int, int, std::less<>, Search> m2;
+    for (int i = 0; i < 1000; i += 2)
+    {
+        m2.insert(i, i);
+    }
+    std::vector<std::pair<int, int>> batch;
+    for (int i = 999; i >= 0; i -= 3)
+    {
+        batch.push_back({i, -i});
+    }
+    batch.push_back({999, 1});
+    m2.insert_bulk(batch.begin(), batch.end());
+    for (int i = 0; i < 1000; i++)
+    {
+        bool in_batch = (999 - i) % 3 == 0;
+        bool present = in_batch || i % 2 == 0;
+        ASSERT(m2.contains(i) == present);
+        if (present)
+        {
+            ASSERT(m2.at(i) == (i == 999 ? 1 : (in_batch ? -i : i)));
+        }
+    }
+    for (int i = 1; i < m2.len(); i++)
+    {
+        ASSERT(m2.key_at(i - 1) < m2.key_at(i));
+    }
+
+    // Sets drop duplicates
+    dsx::structs::flat_set<int, std::less<>, Search> s1 = {5, 1, 3, 3, 1};
+    ASSERT(s1.len() == 3 && s1.key_at(0) == 1 && s1.key_at(2) == 5);
+    std::vector<int> more = {4, 5, 6};
+    s1.insert_bulk(more.begin(), more.end());
+    ASSERT(s1.len() == 5 && s1.contains(4) && s1.contains(6) && !s1.contains(2));
+    ASSERT(s1.insert(2) && !s1.insert(2) && s1.erase(2) && !s1.erase(2));
+    s1.clear();
+    ASSERT(s1.is_empty() && !s1.contains(4));
+}
+
+inline int flat_map_test()
+{
+    flat_map_search_test<dsx::structs::binary_search_policy<int>>();
+    std::cout << "Test 1 (Binary Search Layout) passed!" << std::endl;
+
+    flat_map_search_test<dsx::structs::eytzinger_search_policy<int>>();
+    std::cout << "Test 2 (Eytzinger Layout) passed!" << std::endl;
+
+    // Test 3: Heterogeneous lookup
+    dsx::structs::flat_map<std::string, int> m3 = {{"b", 2}, {"a", 1}};
+    ASSERT(m3.at("a") == 1 && m3.contains(std::string_view("b")));
+    std::cout << "Test 3 (Heterogeneous Lookup) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,539 @@
+/**
+ * @file hash_map.hpp
+ * @brief Definition of the hash_map class, a flat open-addressing hash map
+ * with SIMD-probed control bytes.
+ */
+
+#ifndef LIBDSX_HASH_MAP_H
+#define LIBDSX_HASH_MAP_H
+#include "vector/vector.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace dsx::structs
+{
+/**
+ * @brief Transparent hash for string keys.
+ *
+ * Lets a hash_map<std::string, V> be searched with a std::string_view or a
+ * C string without building a temporary std::string.
+ */
+struct string_hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const noexcept
+    {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+/**
+ * @brief A flat open-addressing hash map in the style of Swiss tables.
+ *
+ * Entries live in one contiguous dsx::structs::vector of slots, next to a
+ * parallel vector of one-byte control words: empty, deleted (tombstone), or
+ * the low 7 bits of the entry's hash. Lookups probe the control bytes 16 at a
+ * time, comparing the whole group against the 7-bit tag with SSE2 (or a
+ * portable fallback), and only touch the slots whose tag matched. Groups are
+ * visited in triangular order, so every group is reached once per lookup.
+ *
+ * The table keeps at most 7/8 of its slots in use (entries plus tombstones)
+ * and rehashes past that, dropping tombstones and doubling if the map is more
+ * than half full.
+ *
+ * Heterogeneous lookup is enabled when both Hash and KeyEqual declare
+ * `is_transparent`.
+ *
+ * @tparam K The key type. Must be default constructible.
+ * @tparam V The mapped type. Must be default constructible.
+ * @tparam Hash The hash function.
+ * @tparam KeyEqual The key comparison.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<>> class hash_map
+{
+  private:
+    static constexpr int _group_width = 16;
+    static constexpr std::int8_t _empty = -128;
+    static constexpr std::int8_t _deleted = -2;
+
+    struct slot
+    {
+        K key;
+        V value;
+    };
+
+    /**
+     * @brief Bit i is set when byte i of a control group matched.
+     */
+    using mask_t = std::uint32_t;
+
+    // The vectors only provide storage: their capacity is the table size, and
+    // the table is never smaller than one group
+    dsx::structs::vector<std::int8_t> _ctrl = dsx::structs::vector<std::int8_t>(_group_width);
+    dsx::structs::vector<slot> _slots = dsx::structs::vector<slot>(_group_width);
+    int _len = {0};
+    int _growth_left = {_group_width - _group_width / 8}; ///< Free slots left before a rehash is due.
+    Hash _hash;
+    KeyEqual _eq;
+
+    static constexpr bool _transparent =
+        requires { typename Hash::is_transparent; } && requires { typename KeyEqual::is_transparent; };
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty table of a single group.
+     */
+    hash_map()
+    {
+        std::memset(_ctrl.data(), static_cast<unsigned char>(_empty), _group_width);
+    }
+
+    /**
+     * @brief Constructor that reserves room for the given number of entries.
+     * @param p_size The number of entries to make room for.
+     */
+    explicit hash_map(int p_size) : hash_map()
+    {
+        reserve(p_size);
+    }
+
+    hash_map(const hash_map &) = delete;
+    hash_map &operator=(const hash_map &) = delete;
+
+  public:
+    /**
+     * @brief Get the number of entries in the map.
+     * @return The number of entries in the map.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _len;
+    }
+
+    /**
+     * @brief Get the number of slots in the table.
+     * @return The current capacity of the map.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        return _slots.capacity();
+    }
+
+    /**
+     * @brief Check if the map is empty.
+     * @return True if the map is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    void reserve(int n_size);
+    void clear();
+
+  public:
+    /**
+     * @brief Looks up a key.
+     *
+     * @param key The key to look for.
+     * @return A pointer to the mapped value, or nullptr if the key is absent.
+     * The pointer is invalidated by the next insertion.
+     */
+    V *find(const K &key) const
+    {
+        return value_at(find_index(key, hash_of(key)));
+    }
+
+    /**
+     * @brief Looks up any type comparable to the key, without converting it.
+     *
+     * Only available when both Hash and KeyEqual are transparent.
+     */
+    template <typename Q>
+        requires _transparent
+    V *find(const Q &key) const
+    {
+        return value_at(find_index(key, hash_of(key)));
+    }
+
+    /**
+     * @brief Checks if the map contains a key.
+     */
+    [[nodiscard]] bool contains(const K &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    template <typename Q>
+        requires _transparent
+    [[nodiscard]] bool contains(const Q &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Returns the value mapped to a key.
+     *
+     * @param key The key to look for.
+     * @return The mapped value.
+     * @throws std::out_of_range If the key is absent.
+     */
+    V at(const K &key) const
+    {
+        return checked(find(key));
+    }
+
+    template <typename Q>
+        requires _transparent
+    V at(const Q &key) const
+    {
+        return checked(find(key));
+    }
+
+  public:
+    template <typename... Args> std::pair<V *, bool> emplace(const K &key, Args &&...args);
+
+    /**
+     * @brief Removes a key.
+     *
+     * @param key The key to remove.
+     * @return An optional containing the removed value, or an empty optional if
+     * the key was absent.
+     */
+    std::optional<V> erase(const K &key)
+    {
+        return erase_index(find_index(key, hash_of(key)));
+    }
+
+    template <typename Q>
+        requires _transparent
+    std::optional<V> erase(const Q &key)
+    {
+        return erase_index(find_index(key, hash_of(key)));
+    }
+
+  private:
+    V *value_at(int idx) const noexcept
+    {
+        return idx < 0 ? nullptr : &_slots.data()[idx].value;
+    }
+
+    static V checked(V *value)
+    {
+        if (!value)
+        {
+            throw std::out_of_range("hash_map::at: key not found");
+        }
+        return *value;
+    }
+
+    std::optional<V> erase_index(int idx);
+
+    /**
+     * @brief Mixes the user hash so that identity hashes (std::hash for
+     * integers) still spread over both the tag and the group index.
+     */
+    template <typename Q> std::size_t hash_of(const Q &key) const
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(_hash(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static std::int8_t tag_of(std::size_t hash) noexcept
+    {
+        return static_cast<std::int8_t>(hash & 0x7f);
+    }
+
+    int group_count() const noexcept
+    {
+        return _ctrl.capacity() / _group_width;
+    }
+
+    static mask_t match(const std::int8_t *group, std::int8_t tag) noexcept;
+    static mask_t match_empty(const std::int8_t *group) noexcept;
+    static mask_t match_empty_or_deleted(const std::int8_t *group) noexcept;
+
+    template <typename Q> int find_index(const Q &key, std::size_t hash) const;
+    int find_insert_slot(std::size_t hash) const;
+    void rehash(int n_cap);
+};
+
+} // namespace dsx::structs
+
+#if defined(__SSE2__)
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::match(
+    const std::int8_t *group, std::int8_t tag) noexcept
+{
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<mask_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::
+    match_empty(const std::int8_t *group) noexcept
+{
+    return match(group, _empty);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::
+    match_empty_or_deleted(const std::int8_t *group) noexcept
+{
+    // Full slots hold a tag in [0, 127], empty and deleted are both below -1
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<mask_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+}
+#else
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::match(
+    const std::int8_t *group, std::int8_t tag) noexcept
+{
+    mask_t mask = 0;
+    for (int i = 0; i < _group_width; i++)
+    {
+        mask |= static_cast<mask_t>(group[i] == tag) << i;
+    }
+    return mask;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::
+    match_empty(const std::int8_t *group) noexcept
+{
+    return match(group, _empty);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename dsx::structs::hash_map<K, V, Hash, KeyEqual>::mask_t dsx::structs::hash_map<K, V, Hash, KeyEqual>::
+    match_empty_or_deleted(const std::int8_t *group) noexcept
+{
+    mask_t mask = 0;
+    for (int i = 0; i < _group_width; i++)
+    {
+        mask |= static_cast<mask_t>(group[i] < -1) << i;
+    }
+    return mask;
+}
+#endif
+
+/**
+ * @brief Returns the slot index holding the key, or -1.
+ *
+ * A group with an empty byte ends the probe: an insertion never skips a group
+ * that still had room.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+int dsx::structs::hash_map<K, V, Hash, KeyEqual>::find_index(const Q &key, std::size_t hash) const
+{
+    int groups = group_count();
+    const std::int8_t *ctrl = _ctrl.data();
+    const slot *slots = _slots.data();
+    std::int8_t tag = tag_of(hash);
+    std::size_t group = (hash >> 7) & (groups - 1);
+
+    for (int step = 1; step <= groups; step++)
+    {
+        const std::int8_t *base = ctrl + group * _group_width;
+        for (mask_t mask = match(base, tag); mask; mask &= mask - 1)
+        {
+            int idx = static_cast<int>(group * _group_width) + std::countr_zero(mask);
+            if (_eq(slots[idx].key, key))
+            {
+                return idx;
+            }
+        }
+        if (match_empty(base))
+        {
+            return -1;
+        }
+        group = (group + step) & (groups - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the first empty or deleted slot on the key's probe sequence.
+ *
+ * The table must have at least one such slot.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+int dsx::structs::hash_map<K, V, Hash, KeyEqual>::find_insert_slot(std::size_t hash) const
+{
+    int groups = group_count();
+    const std::int8_t *ctrl = _ctrl.data();
+    std::size_t group = (hash >> 7) & (groups - 1);
+
+    for (int step = 1;; step++)
+    {
+        if (mask_t mask = match_empty_or_deleted(ctrl + group * _group_width))
+        {
+            return static_cast<int>(group * _group_width) + std::countr_zero(mask);
+        }
+        group = (group + step) & (groups - 1);
+    }
+}
+
+/**
+ * @brief Rebuilds the table with n_cap slots, dropping every tombstone.
+ *
+ * @param n_cap The new number of slots, a power of two and a multiple of the
+ * group width.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void dsx::structs::hash_map<K, V, Hash, KeyEqual>::rehash(int n_cap)
+{
+    // Every new slot is constructed exactly once, by the allocation. After the
+    // swaps old_ctrl and old_slots hold the previous table
+    dsx::structs::vector<std::int8_t> old_ctrl(n_cap);
+    dsx::structs::vector<slot> old_slots(n_cap);
+    std::memset(old_ctrl.data(), static_cast<unsigned char>(_empty), n_cap);
+    old_ctrl.swap(_ctrl);
+    old_slots.swap(_slots);
+    _growth_left = n_cap - n_cap / 8 - _len;
+
+    std::int8_t *ctrl = _ctrl.data();
+    slot *slots = _slots.data();
+    for (int i = 0; i < old_ctrl.capacity(); i++)
+    {
+        if (old_ctrl.data()[i] >= 0)
+        {
+            slot &entry = old_slots.data()[i];
+            std::size_t hash = hash_of(entry.key);
+            int idx = find_insert_slot(hash);
+            ctrl[idx] = tag_of(hash);
+            slots[idx] = std::move(entry);
+        }
+    }
+}
+
+/**
+ * @brief Makes room for n_size entries without further rehashing.
+ *
+ * @param n_size The number of entries to reserve room for.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void dsx::structs::hash_map<K, V, Hash, KeyEqual>::reserve(int n_size)
+{
+    // Smallest power-of-two table that keeps n_size entries under 7/8 load
+    int needed = static_cast<int>(std::bit_ceil(static_cast<unsigned>(n_size + n_size / 7 + 1)));
+    needed = std::max(needed, _group_width);
+    if (needed > capacity())
+    {
+        rehash(needed);
+    }
+}
+
+/**
+ * @brief Removes all entries, keeping the current capacity.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void dsx::structs::hash_map<K, V, Hash, KeyEqual>::clear()
+{
+    int cap = capacity();
+    std::memset(_ctrl.data(), static_cast<unsigned char>(_empty), cap);
+    std::fill(_slots.data(), _slots.data() + cap, slot{});
+    _len = 0;
+    _growth_left = cap - cap / 8;
+}
+
+/**
+ * @brief Inserts an entry if the key is absent.
+ *
+ * @param key The key to insert.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return A pointer to the mapped value and true if it was inserted, or a
+ * pointer to the existing value and false if the key was already present.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<V *, bool> dsx::structs::hash_map<K, V, Hash, KeyEqual>::emplace(const K &key, Args &&...args)
+{
+    std::size_t hash = hash_of(key);
+    int idx = find_index(key, hash);
+    if (idx >= 0)
+    {
+        return {&_slots.data()[idx].value, false};
+    }
+
+    if (_growth_left == 0)
+    {
+        // Mostly tombstones: rebuild in place, otherwise double
+        int cap = capacity();
+        rehash(_len * 2 <= cap - cap / 8 ? cap : cap * 2);
+    }
+
+    // Fill the slot before its control byte marks it full, so a throwing
+    // constructor leaves the map as it was
+    idx = find_insert_slot(hash);
+    slot &entry = _slots.data()[idx];
+    V value(std::forward<Args>(args)...);
+    entry.key = key;
+    entry.value = std::move(value);
+
+    if (_ctrl.data()[idx] == _empty)
+    {
+        --_growth_left; // Reusing a tombstone does not consume growth
+    }
+    _ctrl.data()[idx] = tag_of(hash);
+    ++_len;
+
+    return {&entry.value, true};
+}
+
+/**
+ * @brief Removes the entry in a slot and returns its mapped value.
+ *
+ * The slot becomes a tombstone, unless its group still has an empty byte: no
+ * probe sequence can have passed such a group, so the slot can be marked
+ * empty again.
+ *
+ * @param idx The slot found by find_index(), or -1 if the key was absent.
+ * @return An optional containing the removed value, or an empty optional if
+ * the key was absent.
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+std::optional<V> dsx::structs::hash_map<K, V, Hash, KeyEqual>::erase_index(int idx)
+{
+    if (idx < 0)
+    {
+        return std::nullopt;
+    }
+
+    slot &entry = _slots.data()[idx];
+    V erased_value = std::move(entry.value);
+    entry = slot{};
+
+    std::int8_t *group = _ctrl.data() + (idx / _group_width) * _group_width;
+    if (match_empty(group))
+    {
+        _ctrl.data()[idx] = _empty;
+        ++_growth_left;
+    }
+    else
+    {
+        _ctrl.data()[idx] = _deleted;
+    }
+    --_len;
+
+    return erased_value;
+}
+
+#endif // LIBDSX_HASH_MAP_H
@@ -0,0 +1,110 @@
+#include "hash_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Keys are spread over the whole 64-bit range so that neither map benefits
+// from sequential integers hashing to sequential buckets.
+inline std::vector<std::uint64_t> makeMapKeys(long long count,
+                                              std::uint64_t seed) {
+  std::vector<std::uint64_t> keys;
+  keys.reserve(count);
+  for (long long i = 0; i < count; ++i) {
+    keys.push_back((static_cast<std::uint64_t>(i) + seed) *
+                   0x9E3779B97F4A7C15ULL);
+  }
+  return keys;
+}
+
+struct MapTimings {
+  double insert_ns = 0.0;
+  double hit_ns = 0.0;
+  double miss_ns = 0.0;
+};
+
+// Nanoseconds per operation for inserting every key, then looking up every
+// key (hits) and the same number of absent keys (misses). Lookups run in a
+// shuffled order so that node-based maps do not get to walk their nodes in
+// allocation order.
+template <typename Map, typename Insert, typename Lookup>
+MapTimings benchmarkMap(const std::vector<std::uint64_t> &keys,
+                        const std::vector<std::uint64_t> &absent,
+                        Insert insert, Lookup lookup) {
+  Map map;
+  MapTimings timings;
+  std::vector<std::uint64_t> shuffled = keys;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+  double count = static_cast<double>(keys.size());
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (std::uint64_t key : keys) {
+    insert(map, key);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  timings.insert_ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / count;
+
+  std::uint64_t found = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (std::uint64_t key : shuffled) {
+    found += lookup(map, key);
+  }
+  end = std::chrono::high_resolution_clock::now();
+  timings.hit_ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / count;
+
+  start = std::chrono::high_resolution_clock::now();
+  for (std::uint64_t key : absent) {
+    found += lookup(map, key);
+  }
+  end = std::chrono::high_resolution_clock::now();
+  timings.miss_ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / count;
+
+  if (found != keys.size()) {
+    std::cerr << "Map benchmark lookup mismatch\n";
+  }
+  return timings;
+}
+
+inline int map_bench(int max_exponent = 8) {
+  std::cout << "Benchmarking hash_map vs std::unordered_map (ns/op):\n";
+  std::cout << "------------------------\n";
+
+  for (int e = 3; e <= max_exponent; e++) {
+    long long count = static_cast<long long>(pow(10, e));
+    auto keys = makeMapKeys(count, 0);
+    auto absent = makeMapKeys(count, count);
+
+    MapTimings custom =
+        benchmarkMap<dsx::structs::hash_map<std::uint64_t, std::uint64_t>>(
+            keys, absent,
+            [](auto &map, std::uint64_t key) { map.emplace(key, key); },
+            [](auto &map, std::uint64_t key) {
+              return map.find(key) != nullptr;
+            });
+    MapTimings std_map =
+        benchmarkMap<std::unordered_map<std::uint64_t, std::uint64_t>>(
+            keys, absent,
+            [](auto &map, std::uint64_t key) { map.emplace(key, key); },
+            [](auto &map, std::uint64_t key) {
+              return map.find(key) != map.end();
+            });
+
+    std::cout << "Keys: " << count << std::endl;
+    std::cout << "hash_map insert: " << custom.insert_ns
+              << " hit: " << custom.hit_ns << " miss: " << custom.miss_ns
+              << "\n";
+    std::cout << "std::unordered_map insert: " << std_map.insert_ns
+              << " hit: " << std_map.hit_ns << " miss: " << std_map.miss_ns
+              << "\n";
+    std::cout << "---------------------------------\n";
+  }
+
+  return 0;
+}
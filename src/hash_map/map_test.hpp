@@ -0,0 +1,126 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "hash_map.hpp"
+
+// Helper macro for test assertions
+#ifndef ASSERT
+#define ASSERT(condition)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::cerr << "Assertion failed at line " << __LINE__ << " in function " << __FUNCTION__ << ": "            \
+                      << #condition << std::endl;                                                                      \
+            exit(-1);                                                                                                  \
+        }                                                                                                              \
+    } while (0)
+#endif
+
+inline int hash_map_test()
+{
+    // Test 1: Default constructor
+    dsx::structs::hash_map<int, int> m1;
+    ASSERT(m1.len() == 0 && m1.capacity() == 16);
+    ASSERT(m1.find(1) == nullptr && !m1.erase(1).has_value());
+    std::cout << "Test 1 (Default Constructor) passed!" << std::endl;
+
+    // Test 2: Emplace and find across several rehashes
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT(m1.emplace(i, i * 2).second);
+    }
+    ASSERT(m1.len() == 10000);
+    ASSERT(!m1.emplace(5, 0).second && *m1.emplace(5, 0).first == 10);
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT(m1.contains(i) && m1.at(i) == i * 2);
+    }
+    ASSERT(!m1.contains(-1) && !m1.contains(10000));
+    std::cout << "Test 2 (Emplace and Find) passed!" << std::endl;
+
+    // Test 3: Erase leaves the remaining keys reachable
+    for (int i = 0; i < 10000; i += 2)
+    {
+        auto erased = m1.erase(i);
+        ASSERT(erased.has_value() && erased.value() == i * 2);
+    }
+    ASSERT(m1.len() == 5000);
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT(m1.contains(i) == (i % 2 == 1));
+    }
+    std::cout << "Test 3 (Erase) passed!" << std::endl;
+
+    // Test 4: Tombstones are reclaimed under insert/erase churn
+    dsx::structs::hash_map<int, int> m2(100);
+    int cap = m2.capacity();
+    for (int i = 0; i < 100000; i++)
+    {
+        m2.emplace(i, i);
+        m2.erase(i - 50);
+    }
+    ASSERT(m2.len() == 50 && m2.capacity() == cap);
+    std::cout << "Test 4 (Tombstone Reuse) passed!" << std::endl;
+
+    // Test 5: Heterogeneous lookup on string keys
+    dsx::structs::hash_map<std::string, int, dsx::structs::string_hash> m3;
+    m3.emplace("one", 1);
+    m3.emplace(std::string("two"), 2);
+    ASSERT(m3.at(std::string_view("one")) == 1);
+    ASSERT(m3.contains("two") && !m3.contains("three"));
+    ASSERT(m3.erase(std::string_view("two")).value() == 2);
+    m3.clear();
+    ASSERT(m3.is_empty() && !m3.contains("one"));
+    std::cout << "Test 5 (Heterogeneous Lookup) passed!" << std::endl;
+
+    // Test 6: Keys that convert to K work without a transparent hash
+    dsx::structs::hash_map<std::uint64_t, int> m4;
+    m4.emplace(1, 10);
+    ASSERT(m4.contains(1) && m4.at(1) == 10 && *m4.find(1) == 10);
+    ASSERT(m4.erase(1).value() == 10 && !m4.contains(1));
+    dsx::structs::hash_map<std::string, int> m5;
+    m5.emplace("key", 5);
+    ASSERT(m5.contains("key") && m5.at("key") == 5);
+    std::cout << "Test 6 (Converting Lookup) passed!" << std::endl;
+
+    // Test 7: A throwing value constructor leaves the map unchanged
+    struct picky
+    {
+        int v = 0;
+        picky() = default;
+        explicit picky(int p_v) : v(p_v)
+        {
+            if (p_v < 0)
+            {
+                throw std::invalid_argument("negative");
+            }
+        }
+    };
+    dsx::structs::hash_map<int, picky> m6;
+    m6.emplace(1, 1);
+    bool threw = false;
+    try
+    {
+        m6.emplace(2, -1);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ASSERT(threw && m6.len() == 1 && !m6.contains(2) && m6.at(1).v == 1);
+    for (int i = 3; i < 40; i++)
+    {
+        m6.emplace(i, i); // Rehashes over the slot the failed emplace had picked
+    }
+    ASSERT(m6.len() == 38 && !m6.contains(2));
+    std::cout << "Test 7 (Throwing Emplace) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
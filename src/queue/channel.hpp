@@ -0,0 +1,559 @@
+/**
+ * @file channel.hpp
+ * @brief Definition of the channel class, a bounded queue that coroutines
+ * co_await to send and receive values.
+ */
+
+#ifndef LIBDSX_CHANNEL_H
+#define LIBDSX_CHANNEL_H
+#include "executor.hpp"
+#include "mpmc_queue.hpp"
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace dsx::structs
+{
+/**
+ * @brief A bounded multi-producer multi-consumer channel for coroutines.
+ *
+ * `co_await ch.send(v)` completes once v is in the channel and
+ * `co_await ch.recv()` once a value is available; a full or empty channel
+ * suspends the coroutine instead of blocking its thread.
+ *
+ * Values travel through a lock-free mpmc_queue, and as long as nobody has to
+ * wait, send and recv are a single try_push/try_pop plus one fence. A mutex is
+ * taken only to park a coroutine or to wake a parked one. The coroutine that
+ * frees a parked peer completes the peer's operation on its behalf and then
+ * switches straight to it through symmetric transfer, posting itself to the
+ * executor to continue later; so a receiver waiting on an empty channel runs
+ * on the sender's thread right after the handoff.
+ *
+ * close() makes every later send fail and lets receivers drain what is left;
+ * receivers then get an empty optional. Each operation also takes an optional
+ * std::stop_token that cancels it while it is parked.
+ *
+ * Parked coroutines are resumed in the order they parked, but a coroutine on
+ * the lock-free path may overtake them.
+ *
+ * @tparam T The type of values sent. Must be default constructible and move
+ * assignable.
+ */
+template <typename T> class channel
+{
+  private:
+    enum class wait_state
+    {
+        idle,      ///< Not parked yet.
+        parked,    ///< Linked into a wait list.
+        done,      ///< The operation completed.
+        closed,    ///< The channel was closed first.
+        cancelled, ///< The stop token fired first.
+    };
+
+    /**
+     * @brief A parked operation, living in the awaiting coroutine's frame.
+     */
+    struct waiter
+    {
+        std::coroutine_handle<> handle;
+        wait_state state = wait_state::idle;
+        waiter *prev = nullptr;
+        waiter *next = nullptr;
+        T *send_value = nullptr;        ///< Value to push, for senders.
+        std::optional<T> recv_value;    ///< Value received, for receivers.
+        bool sender = false;
+    };
+
+    /**
+     * @brief Intrusive FIFO of waiters, guarded by the channel mutex.
+     */
+    struct wait_list
+    {
+        waiter *head = nullptr;
+        waiter *tail = nullptr;
+
+        void push_back(waiter *w) noexcept
+        {
+            w->prev = tail;
+            w->next = nullptr;
+            (tail ? tail->next : head) = w;
+            tail = w;
+        }
+
+        void unlink(waiter *w) noexcept
+        {
+            (w->prev ? w->prev->next : head) = w->next;
+            (w->next ? w->next->prev : tail) = w->prev;
+            w->prev = w->next = nullptr;
+        }
+    };
+
+    /**
+     * @brief Stop callback that takes a parked waiter off its list.
+     */
+    struct canceller
+    {
+        channel *ch;
+        waiter *w;
+
+        void operator()() noexcept
+        {
+            ch->cancel(*w);
+        }
+    };
+
+    mpmc_queue<T> _buffer;
+    executor &_executor;
+    std::mutex _mutex;
+    wait_list _senders;
+    wait_list _receivers;
+    std::atomic<int> _parked_senders = {0};
+    std::atomic<int> _parked_receivers = {0};
+    std::atomic<bool> _closed = {false};
+
+  public:
+    /**
+     * @brief Awaiter returned by send(); co_await yields true if the value was
+     * sent and false if the channel was closed or the operation cancelled.
+     */
+    class send_awaiter
+    {
+      private:
+        channel &_ch;
+        T _value;
+        std::stop_token _token;
+        waiter _waiter;
+        bool _pushed = false; ///< Pushed on the fast path, but a receiver is parked.
+        std::optional<std::stop_callback<canceller>> _on_stop;
+
+      public:
+        send_awaiter(channel &ch, T value, std::stop_token token)
+            : _ch(ch), _value(std::move(value)), _token(std::move(token))
+        {
+            _waiter.sender = true;
+            _waiter.send_value = &_value;
+        }
+
+        bool await_ready()
+        {
+            if (_token.stop_requested())
+            {
+                _waiter.state = wait_state::cancelled;
+                return true;
+            }
+            if (_ch._closed.load(std::memory_order_acquire))
+            {
+                _waiter.state = wait_state::closed;
+                return true;
+            }
+            if (_ch._buffer.try_push(_value))
+            {
+                _waiter.state = wait_state::done;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                _pushed = _ch._parked_receivers.load(std::memory_order_relaxed) > 0;
+                return !_pushed;
+            }
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self)
+        {
+            if (_pushed)
+            {
+                std::unique_lock lock(_ch._mutex);
+                waiter *peer = _ch.wake_receivers();
+                lock.unlock();
+                return _ch.hand_over(self, peer);
+            }
+
+            _waiter.handle = self;
+            if (_token.stop_possible())
+            {
+                _on_stop.emplace(_token, canceller{&_ch, &_waiter});
+            }
+
+            std::unique_lock lock(_ch._mutex);
+            if (_waiter.state == wait_state::cancelled)
+            {
+                return self;
+            }
+            if (_ch._closed.load(std::memory_order_relaxed))
+            {
+                _waiter.state = wait_state::closed;
+                return self;
+            }
+
+            // Announce the wait before the last try so a concurrent recv either
+            // frees the slot for this push or sees the counter
+            _ch._parked_senders.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_ch._buffer.try_push(_value))
+            {
+                _ch._parked_senders.fetch_sub(1, std::memory_order_relaxed);
+                _waiter.state = wait_state::done;
+                waiter *peer = _ch.wake_receivers();
+                lock.unlock();
+                return _ch.hand_over(self, peer);
+            }
+
+            _waiter.state = wait_state::parked;
+            _ch._senders.push_back(&_waiter);
+            return std::noop_coroutine();
+        }
+
+        bool await_resume() const noexcept
+        {
+            return _waiter.state == wait_state::done;
+        }
+    };
+
+    /**
+     * @brief Awaiter returned by recv(); co_await yields the value, or an empty
+     * optional if the channel is closed and drained or the operation was
+     * cancelled.
+     */
+    class recv_awaiter
+    {
+      private:
+        channel &_ch;
+        std::stop_token _token;
+        waiter _waiter;
+        bool _popped = false; ///< Popped on the fast path, but a sender is parked.
+        std::optional<std::stop_callback<canceller>> _on_stop;
+
+      public:
+        recv_awaiter(channel &ch, std::stop_token token) : _ch(ch), _token(std::move(token))
+        {
+        }
+
+        bool await_ready()
+        {
+            if (_token.stop_requested())
+            {
+                _waiter.state = wait_state::cancelled;
+                return true;
+            }
+            if (take())
+            {
+                return !_popped;
+            }
+            if (_ch._closed.load(std::memory_order_acquire))
+            {
+                // Values sent before close() stay receivable
+                if (take())
+                {
+                    return !_popped;
+                }
+                _waiter.state = wait_state::closed;
+                return true;
+            }
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self)
+        {
+            if (_popped)
+            {
+                std::unique_lock lock(_ch._mutex);
+                waiter *peer = _ch.wake_senders();
+                lock.unlock();
+                return _ch.hand_over(self, peer);
+            }
+
+            _waiter.handle = self;
+            if (_token.stop_possible())
+            {
+                _on_stop.emplace(_token, canceller{&_ch, &_waiter});
+            }
+
+            std::unique_lock lock(_ch._mutex);
+            if (_waiter.state == wait_state::cancelled)
+            {
+                return self;
+            }
+
+            // Announce the wait before the last try so a concurrent send either
+            // lands in this pop or sees the counter
+            _ch._parked_receivers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (auto value = _ch._buffer.try_pop())
+            {
+                _ch._parked_receivers.fetch_sub(1, std::memory_order_relaxed);
+                _waiter.recv_value = std::move(value);
+                _waiter.state = wait_state::done;
+                waiter *peer = _ch.wake_senders();
+                lock.unlock();
+                return _ch.hand_over(self, peer);
+            }
+            if (_ch._closed.load(std::memory_order_relaxed))
+            {
+                _ch._parked_receivers.fetch_sub(1, std::memory_order_relaxed);
+                _waiter.state = wait_state::closed;
+                return self;
+            }
+
+            _waiter.state = wait_state::parked;
+            _ch._receivers.push_back(&_waiter);
+            return std::noop_coroutine();
+        }
+
+        std::optional<T> await_resume() noexcept
+        {
+            return std::move(_waiter.recv_value);
+        }
+
+      private:
+        /**
+         * @brief Lock-free pop; notes whether a parked sender needs waking.
+         */
+        bool take()
+        {
+            auto value = _ch._buffer.try_pop();
+            if (!value)
+            {
+                return false;
+            }
+            _waiter.recv_value = std::move(value);
+            _waiter.state = wait_state::done;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _popped = _ch._parked_senders.load(std::memory_order_relaxed) > 0;
+            return true;
+        }
+    };
+
+  public:
+    /**
+     * @brief Constructor for a channel holding up to p_capacity values.
+     *
+     * @param p_capacity The buffer size, rounded up to a power of two (at least
+     * 2, see mpmc_queue).
+     * @param ex The executor that resumes coroutines handed over by this
+     * channel. Every coroutine using the channel should run on it.
+     * @throws std::invalid_argument If p_capacity is not positive.
+     */
+    channel(int p_capacity, executor &ex) : _buffer(p_capacity), _executor(ex)
+    {
+    }
+
+    channel(const channel &) = delete;
+    channel &operator=(const channel &) = delete;
+
+    /**
+     * @brief Get the number of values the channel buffers.
+     * @return The capacity of the channel.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        return _buffer.capacity();
+    }
+
+    /**
+     * @brief Get the number of buffered values, which may already be stale.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _buffer.len();
+    }
+
+    /**
+     * @brief Check if close() was called.
+     */
+    [[nodiscard]] bool is_closed() const
+    {
+        return _closed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Sends a value; co_await the result.
+     *
+     * @param value The value to send.
+     * @param token Cancels the send while it waits for room.
+     */
+    [[nodiscard]] send_awaiter send(T value, std::stop_token token = {})
+    {
+        return send_awaiter(*this, std::move(value), std::move(token));
+    }
+
+    /**
+     * @brief Receives a value; co_await the result.
+     *
+     * @param token Cancels the receive while it waits for a value.
+     */
+    [[nodiscard]] recv_awaiter recv(std::stop_token token = {})
+    {
+        return recv_awaiter(*this, std::move(token));
+    }
+
+    void close();
+
+  private:
+    waiter *wake_receivers();
+    waiter *wake_senders();
+    std::coroutine_handle<> hand_over(std::coroutine_handle<> self, waiter *peer);
+    void cancel(waiter &w) noexcept;
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Closes the channel.
+ *
+ * Parked senders resume with false; parked receivers get a buffered value if
+ * one is left and an empty optional otherwise. Later sends fail at once and
+ * later receives drain the buffer. A send racing with close() may still
+ * succeed, in which case its value stays receivable.
+ */
+template <typename T> void dsx::structs::channel<T>::close()
+{
+    std::vector<std::coroutine_handle<>> resumed;
+    {
+        std::lock_guard lock(_mutex);
+        if (_closed.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        for (wait_list *list : {&_senders, &_receivers})
+        {
+            while (waiter *w = list->head)
+            {
+                list->unlink(w);
+                w->state = wait_state::closed;
+                if (!w->sender && (w->recv_value = _buffer.try_pop()))
+                {
+                    w->state = wait_state::done;
+                }
+                resumed.push_back(w->handle);
+            }
+        }
+        _parked_senders.store(0, std::memory_order_relaxed);
+        _parked_receivers.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto handle : resumed)
+    {
+        _executor.post(handle);
+    }
+}
+
+/**
+ * @brief Pops a value for each parked receiver, oldest first, for as long as
+ * the buffer has one. Called with the mutex held.
+ *
+ * A single pop is not enough: a pop fails while an earlier push has claimed
+ * its slot but not filled it yet, and the sender that fills it may be the
+ * only one left to look at the parked receivers. So whoever gets here hands
+ * out every value it can reach, including those other senders pushed.
+ *
+ * @return The receivers, now done and unlinked and chained through `next`,
+ * or nullptr if none could be served.
+ */
+template <typename T> typename dsx::structs::channel<T>::waiter *dsx::structs::channel<T>::wake_receivers()
+{
+    waiter *first = nullptr;
+    waiter *last = nullptr;
+    while (waiter *w = _receivers.head)
+    {
+        if (!(w->recv_value = _buffer.try_pop()))
+        {
+            break;
+        }
+
+        _receivers.unlink(w);
+        _parked_receivers.fetch_sub(1, std::memory_order_relaxed);
+        w->state = wait_state::done;
+        (last ? last->next : first) = w;
+        last = w;
+    }
+    return first;
+}
+
+/**
+ * @brief Pushes the value of each parked sender, oldest first, for as long as
+ * the buffer has room. Called with the mutex held.
+ *
+ * The mirror image of wake_receivers(): a push fails while an earlier pop has
+ * claimed its slot but not released it yet.
+ *
+ * @return The senders, now done and unlinked and chained through `next`, or
+ * nullptr if none could be served.
+ */
+template <typename T> typename dsx::structs::channel<T>::waiter *dsx::structs::channel<T>::wake_senders()
+{
+    waiter *first = nullptr;
+    waiter *last = nullptr;
+    while (waiter *w = _senders.head)
+    {
+        if (!_buffer.try_push(*w->send_value))
+        {
+            break;
+        }
+
+        _senders.unlink(w);
+        _parked_senders.fetch_sub(1, std::memory_order_relaxed);
+        w->state = wait_state::done;
+        (last ? last->next : first) = w;
+        last = w;
+    }
+    return first;
+}
+
+/**
+ * @brief Picks the coroutine to run after a completed operation.
+ *
+ * With woken peers, the current coroutine and every peer but the first are
+ * posted to the executor and control transfers straight to the first peer;
+ * otherwise the current coroutine simply continues.
+ */
+template <typename T>
+std::coroutine_handle<> dsx::structs::channel<T>::hand_over(std::coroutine_handle<> self, waiter *peer)
+{
+    if (!peer)
+    {
+        return self;
+    }
+
+    waiter *rest = peer->next;
+    while (rest)
+    {
+        waiter *next = rest->next; // rest lives in a frame that may be gone once posted
+        _executor.post(rest->handle);
+        rest = next;
+    }
+
+    std::coroutine_handle<> next = peer->handle;
+    _executor.post(self); // self may resume on another thread from here on
+    return next;
+}
+
+/**
+ * @brief Stop-token callback: cancels the operation unless it already
+ * finished.
+ */
+template <typename T> void dsx::structs::channel<T>::cancel(waiter &w) noexcept
+{
+    std::unique_lock lock(_mutex);
+    if (w.state == wait_state::idle)
+    {
+        w.state = wait_state::cancelled; // await_suspend checks this before parking
+        return;
+    }
+    if (w.state != wait_state::parked)
+    {
+        return;
+    }
+
+    (w.sender ? _senders : _receivers).unlink(&w);
+    (w.sender ? _parked_senders : _parked_receivers).fetch_sub(1, std::memory_order_relaxed);
+    w.state = wait_state::cancelled;
+    std::coroutine_handle<> handle = w.handle;
+    lock.unlock();
+    _executor.post(handle);
+}
+
+#endif // LIBDSX_CHANNEL_H
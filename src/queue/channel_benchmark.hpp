@@ -0,0 +1,116 @@
+#include "channel.hpp"
+#include "executor.hpp"
+#include <chrono>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <vector>
+
+namespace channel_bench_detail {
+inline dsx::structs::task sendAll(dsx::structs::channel<int> &ch, int count,
+                                  std::latch *done) {
+  for (int i = 0; i < count; ++i) {
+    co_await ch.send(i);
+  }
+  ch.close();
+  if (done) {
+    done->count_down();
+  }
+}
+
+inline dsx::structs::task forward(dsx::structs::channel<int> &in,
+                                  dsx::structs::channel<int> &out) {
+  while (auto value = co_await in.recv()) {
+    co_await out.send(*value);
+  }
+  out.close();
+}
+
+inline dsx::structs::task drain(dsx::structs::channel<int> &ch, long long &sum,
+                                std::latch *done) {
+  while (auto value = co_await ch.recv()) {
+    sum += *value;
+  }
+  if (done) {
+    done->count_down();
+  }
+}
+} // namespace channel_bench_detail
+
+// Handoffs per second through `stages` channels chained by forwarding
+// coroutines, all on one thread. A handoff is one value crossing one channel.
+inline double benchmarkChannelPipeline(int capacity, int stages, int count) {
+  using namespace channel_bench_detail;
+  dsx::structs::single_thread_executor loop;
+  std::vector<std::unique_ptr<dsx::structs::channel<int>>> channels;
+  for (int s = 0; s < stages; ++s) {
+    channels.push_back(
+        std::make_unique<dsx::structs::channel<int>>(capacity, loop));
+  }
+
+  long long sum = 0;
+  drain(*channels.back(), sum, nullptr).start(loop);
+  for (int s = stages - 1; s > 0; --s) {
+    forward(*channels[s - 1], *channels[s]).start(loop);
+  }
+  sendAll(*channels.front(), count, nullptr).start(loop);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  loop.run();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (sum != static_cast<long long>(count) * (count - 1) / 2) {
+    std::cerr << "channel pipeline lost values\n";
+  }
+  std::chrono::duration<double> duration = end - start;
+  return static_cast<double>(count) * stages / duration.count();
+}
+
+// Handoffs per second from one producer to one consumer on a thread pool.
+inline double benchmarkChannelPool(int capacity, int threads, int count) {
+  using namespace channel_bench_detail;
+  dsx::structs::thread_pool_executor pool(threads);
+  dsx::structs::channel<int> ch(capacity, pool);
+  std::latch done(2);
+  long long sum = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  drain(ch, sum, &done).start(pool);
+  sendAll(ch, count, &done).start(pool);
+  done.wait();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (sum != static_cast<long long>(count) * (count - 1) / 2) {
+    std::cerr << "channel pool lost values\n";
+  }
+  std::chrono::duration<double> duration = end - start;
+  return count / duration.count();
+}
+
+inline int channel_bench() {
+  constexpr int count = 1000000;
+
+  std::cout << "Channel handoffs/sec, single-threaded executor (" << count
+            << " values):\n";
+  std::cout << "------------------------\n";
+  for (int capacity : {2, 64, 1024}) {
+    std::cout << "Capacity: " << capacity << std::endl;
+    std::cout << "1 stage: " << benchmarkChannelPipeline(capacity, 1, count)
+              << " handoffs/s\n";
+    std::cout << "4 stages: " << benchmarkChannelPipeline(capacity, 4, count)
+              << " handoffs/s\n";
+    std::cout << "---------------------------------\n";
+  }
+
+  std::cout << "\nChannel handoffs/sec, thread pool, 1 producer 1 consumer:\n";
+  std::cout << "------------------------\n";
+  for (int threads : {1, 2, 4}) {
+    for (int capacity : {2, 1024}) {
+      std::cout << "Threads: " << threads << " capacity: " << capacity << ": "
+                << benchmarkChannelPool(capacity, threads, count)
+                << " handoffs/s\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,280 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <latch>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "channel.hpp"
+#include "mpmc_queue.hpp"
+
+// Helper macro for test assertions
+#ifndef ASSERT
+#define ASSERT(condition)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::cerr << "Assertion failed at line " << __LINE__ << " in function " << __FUNCTION__ << ": "            \
+                      << #condition << std::endl;                                                                      \
+            exit(-1);                                                                                                  \
+        }                                                                                                              \
+    } while (0)
+#endif
+
+namespace channel_test_detail
+{
+inline dsx::structs::task produce(dsx::structs::channel<int> &ch, int from, int count, bool close_after)
+{
+    for (int i = from; i < from + count; i++)
+    {
+        co_await ch.send(i);
+    }
+    if (close_after)
+    {
+        ch.close();
+    }
+}
+
+inline dsx::structs::task collect(dsx::structs::channel<int> &ch, std::vector<int> &out)
+{
+    while (auto value = co_await ch.recv())
+    {
+        out.push_back(*value);
+    }
+}
+
+inline dsx::structs::task relay(dsx::structs::channel<int> &in, dsx::structs::channel<int> &out)
+{
+    while (auto value = co_await in.recv())
+    {
+        co_await out.send(*value * 2);
+    }
+    out.close();
+}
+
+inline dsx::structs::task try_send(dsx::structs::channel<std::string> &ch, std::string value, std::stop_token token,
+                                   std::optional<bool> &result)
+{
+    result = co_await ch.send(std::move(value), token);
+}
+
+inline dsx::structs::task try_recv(dsx::structs::channel<std::string> &ch, std::stop_token token, bool &finished,
+                                   std::optional<std::string> &result)
+{
+    result = co_await ch.recv(token);
+    finished = true;
+}
+
+inline dsx::structs::task pool_produce(dsx::structs::channel<int> &ch, int from, int count, std::latch &done)
+{
+    for (int i = from; i < from + count; i++)
+    {
+        co_await ch.send(i);
+    }
+    done.count_down();
+}
+
+inline dsx::structs::task pool_consume(dsx::structs::channel<int> &ch, std::atomic<long long> &sum,
+                                       std::atomic<int> &received, std::latch &done)
+{
+    while (auto value = co_await ch.recv())
+    {
+        sum.fetch_add(*value, std::memory_order_relaxed);
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+    done.count_down();
+}
+/**
+ * @brief A value whose move assignment (the write into a buffer slot) is slow,
+ * so a push holds its claimed slot unpublished for a while.
+ */
+struct slow_value
+{
+    int v = 0;
+
+    slow_value() = default;
+    slow_value(int p_v) : v(p_v)
+    {
+    }
+    slow_value(const slow_value &) = default;
+    slow_value(slow_value &&) = default;
+    slow_value &operator=(const slow_value &) = default;
+    slow_value &operator=(slow_value &&other)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        v = other.v;
+        return *this;
+    }
+};
+
+inline dsx::structs::task slow_send(dsx::structs::channel<slow_value> &ch, int value, std::latch &done)
+{
+    co_await ch.send(slow_value(value));
+    done.count_down();
+}
+
+inline dsx::structs::task slow_recv(dsx::structs::channel<slow_value> &ch, std::atomic<int> &received,
+                                    std::latch &done)
+{
+    std::optional<slow_value> value = co_await ch.recv();
+    if (value)
+    {
+        received.fetch_add(1);
+    }
+    done.count_down();
+}
+} // namespace channel_test_detail
+
+inline int channel_test()
+{
+    using namespace channel_test_detail;
+
+    // Test 1: The lock-free ring is a bounded FIFO
+    dsx::structs::mpmc_queue<int> tiny(1);
+    ASSERT(tiny.capacity() == 2);
+    dsx::structs::mpmc_queue<int> ring(3);
+    ASSERT(ring.capacity() == 4 && ring.is_empty());
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT(ring.try_push(i));
+    }
+    int extra = 4;
+    ASSERT(!ring.try_push(extra) && ring.len() == 4);
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT(ring.try_pop() == i);
+    }
+    ASSERT(!ring.try_pop().has_value());
+    std::cout << "Test 1 (MPMC Ring) passed!" << std::endl;
+
+    // Test 2: A producer and a consumer hand over every value in order
+    dsx::structs::single_thread_executor loop;
+    dsx::structs::channel<int> ch2(2, loop);
+    std::vector<int> received;
+    collect(ch2, received).start(loop);
+    produce(ch2, 0, 1000, true).start(loop);
+    loop.run();
+    ASSERT(received.size() == 1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT(received[i] == i);
+    }
+    std::cout << "Test 2 (Ordered Handoff) passed!" << std::endl;
+
+    // Test 3: Stages pipeline without a thread each, close propagates
+    dsx::structs::channel<int> in(1, loop), out(1, loop);
+    std::vector<int> doubled;
+    collect(out, doubled).start(loop);
+    relay(in, out).start(loop);
+    produce(in, 1, 100, true).start(loop);
+    loop.run();
+    ASSERT(doubled.size() == 100 && doubled.front() == 2 && doubled.back() == 200);
+    ASSERT(in.is_closed() && out.is_closed());
+    std::cout << "Test 3 (Pipeline) passed!" << std::endl;
+
+    // Test 4: close() fails parked senders and later sends, buffered values drain
+    dsx::structs::channel<std::string> ch4(2, loop);
+    std::optional<bool> first, second, dropped, late;
+    try_send(ch4, "first", {}, first).start(loop);
+    try_send(ch4, "second", {}, second).start(loop);
+    try_send(ch4, "dropped", {}, dropped).start(loop);
+    loop.run();
+    ASSERT(first == true && second == true && !dropped.has_value());
+    ch4.close();
+    loop.run();
+    ASSERT(dropped == false);
+    try_send(ch4, "late", {}, late).start(loop);
+    bool done[3] = {};
+    std::optional<std::string> drained[3];
+    for (int i = 0; i < 3; i++)
+    {
+        try_recv(ch4, {}, done[i], drained[i]).start(loop);
+    }
+    loop.run();
+    ASSERT(late == false);
+    ASSERT(done[0] && drained[0] == "first" && done[1] && drained[1] == "second");
+    ASSERT(done[2] && !drained[2].has_value());
+    std::cout << "Test 4 (Close) passed!" << std::endl;
+
+    // Test 5: A stop token cancels a parked receive, the channel keeps working
+    dsx::structs::channel<std::string> ch5(1, loop);
+    std::stop_source stop;
+    bool cancelled_done = false, normal_done = false;
+    std::optional<std::string> cancelled_value, normal_value;
+    try_recv(ch5, stop.get_token(), cancelled_done, cancelled_value).start(loop);
+    try_recv(ch5, {}, normal_done, normal_value).start(loop);
+    loop.run();
+    ASSERT(!cancelled_done && !normal_done);
+    stop.request_stop();
+    loop.run();
+    ASSERT(cancelled_done && !cancelled_value.has_value() && !ch5.is_closed());
+    std::optional<bool> sent;
+    try_send(ch5, "hello", {}, sent).start(loop);
+    loop.run();
+    ASSERT(sent == true && normal_done && normal_value == "hello");
+    try_recv(ch5, stop.get_token(), cancelled_done, cancelled_value).start(loop);
+    ASSERT(loop.run() == 1 && !cancelled_value.has_value());
+    std::cout << "Test 5 (Cancellation) passed!" << std::endl;
+
+    // Test 6: Many producers and consumers on a thread pool lose nothing
+    {
+        constexpr int producers = 4, consumers = 4, per_producer = 20000;
+        dsx::structs::thread_pool_executor pool(4);
+        dsx::structs::channel<int> ch6(8, pool);
+        std::atomic<long long> sum = {0};
+        std::atomic<int> count = {0};
+        std::latch produced(producers), consumed(consumers);
+        for (int c = 0; c < consumers; c++)
+        {
+            pool_consume(ch6, sum, count, consumed).start(pool);
+        }
+        for (int p = 0; p < producers; p++)
+        {
+            pool_produce(ch6, p * per_producer, per_producer, produced).start(pool);
+        }
+        produced.wait();
+        ch6.close();
+        consumed.wait();
+        long long n = producers * per_producer;
+        ASSERT(count.load() == n && sum.load() == n * (n - 1) / 2);
+    }
+    std::cout << "Test 6 (Thread Pool) passed!" << std::endl;
+
+    // Test 7: Concurrent sends reach every parked receiver without close()
+    for (int round = 0; round < 3; round++)
+    {
+        constexpr int peers = 4;
+        dsx::structs::thread_pool_executor pool(4);
+        dsx::structs::channel<slow_value> ch7(8, pool);
+        std::atomic<int> got = {0};
+        std::latch finished(2 * peers);
+        for (int r = 0; r < peers; r++)
+        {
+            slow_recv(ch7, got, finished).start(pool);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Let them park
+        for (int s = 0; s < peers; s++)
+        {
+            slow_send(ch7, s, finished).start(pool);
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (got.load() < peers && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        int received_before_close = got.load();
+        ch7.close(); // Releases any receiver that missed its wakeup before asserting
+        finished.wait();
+        ASSERT(received_before_close == peers && ch7.len() == 0);
+    }
+    std::cout << "Test 7 (Parked Receivers) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file executor.hpp
+ * @brief Definition of the task coroutine type and the executors that run it:
+ * a single-threaded run loop and a fixed thread pool.
+ */
+
+#ifndef LIBDSX_EXECUTOR_H
+#define LIBDSX_EXECUTOR_H
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dsx::structs
+{
+/**
+ * @brief Something that resumes coroutine handles, possibly on another thread.
+ */
+class executor
+{
+  public:
+    virtual ~executor() = default;
+
+    /**
+     * @brief Queues a suspended coroutine to be resumed later.
+     *
+     * Safe to call from any thread. The handle must not be resumed or destroyed
+     * by anyone else afterwards.
+     */
+    virtual void post(std::coroutine_handle<> handle) = 0;
+};
+
+/**
+ * @brief A fire-and-forget coroutine.
+ *
+ * A task does nothing until it is started on an executor and frees its frame
+ * when it returns. An exception escaping the coroutine calls std::terminate().
+ */
+class task
+{
+  public:
+    struct promise_type
+    {
+        task get_return_object() noexcept
+        {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+  private:
+    std::coroutine_handle<promise_type> _handle;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle)
+    {
+    }
+
+  public:
+    task(task &&other) noexcept : _handle(std::exchange(other._handle, {}))
+    {
+    }
+
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+    task &operator=(task &&) = delete;
+
+    /**
+     * @brief Destroys the coroutine if it was never started.
+     */
+    ~task()
+    {
+        if (_handle)
+        {
+            _handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Hands the coroutine to an executor, which will run it up to its
+     * first suspension point when it gets to it.
+     * @throws std::logic_error If the task was already started.
+     */
+    void start(executor &ex)
+    {
+        if (!_handle)
+        {
+            throw std::logic_error("task was already started");
+        }
+        ex.post(std::exchange(_handle, {}));
+    }
+};
+
+/**
+ * @brief Runs coroutines one at a time on the thread that calls run().
+ *
+ * post() may be called from any thread, but every coroutine is resumed inside
+ * run(), so coroutines that only share state through this executor need no
+ * further synchronisation.
+ */
+class single_thread_executor : public executor
+{
+  private:
+    std::mutex _mutex;
+    std::deque<std::coroutine_handle<>> _ready;
+
+  public:
+    void post(std::coroutine_handle<> handle) override
+    {
+        std::lock_guard lock(_mutex);
+        _ready.push_back(handle);
+    }
+
+    /**
+     * @brief Resumes queued coroutines until none are left.
+     *
+     * Coroutines suspended on something that is not this executor (e.g. a
+     * channel nobody else touches) stay suspended.
+     *
+     * @return The number of coroutines resumed.
+     */
+    long long run()
+    {
+        long long resumed = 0;
+        for (;;)
+        {
+            std::coroutine_handle<> next;
+            {
+                std::lock_guard lock(_mutex);
+                if (_ready.empty())
+                {
+                    return resumed;
+                }
+                next = _ready.front();
+                _ready.pop_front();
+            }
+            next.resume();
+            ++resumed;
+        }
+    }
+};
+
+/**
+ * @brief Resumes coroutines on a fixed set of worker threads.
+ *
+ * The destructor joins the workers after the queue drains. Coroutines still
+ * suspended elsewhere at that point are not resumed, so callers should wait
+ * for their tasks to finish (e.g. with a std::latch) first.
+ */
+class thread_pool_executor : public executor
+{
+  private:
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<std::coroutine_handle<>> _ready;
+    bool _stopping = false;
+    std::vector<std::thread> _workers;
+
+  public:
+    /**
+     * @brief Constructor that starts p_threads workers.
+     * @throws std::invalid_argument If p_threads is not positive.
+     */
+    explicit thread_pool_executor(int p_threads)
+    {
+        if (p_threads <= 0)
+        {
+            throw std::invalid_argument("thread_pool_executor needs at least one thread, got " +
+                                        std::to_string(p_threads));
+        }
+        for (int i = 0; i < p_threads; i++)
+        {
+            _workers.emplace_back([this] { work(); });
+        }
+    }
+
+    thread_pool_executor(const thread_pool_executor &) = delete;
+    thread_pool_executor &operator=(const thread_pool_executor &) = delete;
+
+    ~thread_pool_executor() override
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto &worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    void post(std::coroutine_handle<> handle) override
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _ready.push_back(handle);
+        }
+        _wake.notify_one();
+    }
+
+  private:
+    void work()
+    {
+        for (;;)
+        {
+            std::coroutine_handle<> next;
+            {
+                std::unique_lock lock(_mutex);
+                _wake.wait(lock, [this] { return _stopping || !_ready.empty(); });
+                if (_ready.empty())
+                {
+                    return; // Stopping and drained
+                }
+                next = _ready.front();
+                _ready.pop_front();
+            }
+            next.resume();
+        }
+    }
+};
+
+} // namespace dsx::structs
+
+#endif // LIBDSX_EXECUTOR_H
@@ -0,0 +1,189 @@
+/**
+ * @file mpmc_queue.hpp
+ * @brief Definition of the mpmc_queue class, a bounded lock-free FIFO that any
+ * number of threads can push to and pop from.
+ */
+
+#ifndef LIBDSX_MPMC_QUEUE_H
+#define LIBDSX_MPMC_QUEUE_H
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dsx::structs
+{
+/**
+ * @brief A bounded multi-producer multi-consumer ring buffer.
+ *
+ * Every slot carries a sequence number that tells producers and consumers
+ * whose turn it is, so try_push() and try_pop() each claim a position with one
+ * compare-and-swap on the shared head or tail and never block. A full queue
+ * makes try_push() fail and an empty one makes try_pop() fail.
+ *
+ * The capacity is rounded up to a power of two, and to at least 2, so positions
+ * map to slots with a mask; with a single slot the sequence numbers for "full"
+ * and "free on the next lap" would be the same.
+ *
+ * @tparam T The type of elements held in the queue. Must be default
+ * constructible and move assignable.
+ */
+template <typename T> class mpmc_queue
+{
+  private:
+    struct slot
+    {
+        std::atomic<std::size_t> seq;
+        T val;
+    };
+
+    static constexpr std::size_t _line = 64; ///< Keeps head and tail on separate cache lines.
+
+    slot *_slots = nullptr;
+    std::size_t _mask = 0;
+    alignas(_line) std::atomic<std::size_t> _head = {0}; ///< Next position to pop.
+    alignas(_line) std::atomic<std::size_t> _tail = {0}; ///< Next position to push.
+
+  public:
+    /**
+     * @brief Constructor that allocates room for at least p_capacity elements.
+     * @throws std::invalid_argument If p_capacity is not positive.
+     */
+    explicit mpmc_queue(int p_capacity)
+    {
+        if (p_capacity <= 0)
+        {
+            throw std::invalid_argument("mpmc_queue capacity must be positive, got " + std::to_string(p_capacity));
+        }
+
+        std::size_t size = std::bit_ceil(std::max<std::size_t>(2, p_capacity));
+        _slots = new slot[size];
+        _mask = size - 1;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+    /**
+     * @brief Destructor. Must not run concurrently with any other operation.
+     */
+    ~mpmc_queue()
+    {
+        delete[] _slots;
+    }
+
+  public:
+    /**
+     * @brief Get the number of slots.
+     * @return The capacity of the queue.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        return static_cast<int>(_mask + 1);
+    }
+
+    /**
+     * @brief Get the number of elements, which may already be stale while
+     * other threads push or pop.
+     */
+    [[nodiscard]] int len() const
+    {
+        std::size_t tail = _tail.load(std::memory_order_acquire);
+        std::size_t head = _head.load(std::memory_order_acquire);
+        return tail > head ? static_cast<int>(tail - head) : 0;
+    }
+
+    /**
+     * @brief Check if the queue is empty, with the same caveat as len().
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    bool try_push(T &elt);
+    std::optional<T> try_pop();
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Appends an element if there is a free slot.
+ *
+ * The element is moved from only when the push succeeds, so a caller can keep
+ * retrying with the same object.
+ *
+ * @param elt The element to add.
+ * @return True if the element was added, false if the queue was full.
+ */
+template <typename T> bool dsx::structs::mpmc_queue<T>::try_push(T &elt)
+{
+    std::size_t pos = _tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        slot &s = _slots[pos & _mask];
+        std::size_t seq = s.seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+        if (diff == 0)
+        {
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                s.val = std::move(elt);
+                s.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false; // The slot still holds the element from one lap ago
+        }
+        else
+        {
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Removes the oldest element if there is one.
+ *
+ * @return An optional containing the element, or an empty optional if the
+ * queue was empty.
+ */
+template <typename T> std::optional<T> dsx::structs::mpmc_queue<T>::try_pop()
+{
+    std::size_t pos = _head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        slot &s = _slots[pos & _mask];
+        std::size_t seq = s.seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0)
+        {
+            if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                std::optional<T> popped = std::move(s.val);
+                s.seq.store(pos + _mask + 1, std::memory_order_release);
+                return popped;
+            }
+        }
+        else if (diff < 0)
+        {
+            return std::nullopt; // Nothing has been pushed to this slot yet
+        }
+        else
+        {
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+#endif // LIBDSX_MPMC_QUEUE_H
@@ -7,6 +7,7 @@
 
 #ifndef LIBDSX_LINKED_LIST_H
 #define LIBDSX_LINKED_LIST_H
+#include "stats/container_stats.hpp"
 #include <initializer_list>
 
 #include <source_location>
@@ -16,8 +17,10 @@
 /**
  * @brief A generic doubly-linked list implementation.
  * @tparam T The type of elements stored in the list.
+ * @tparam Stats The statistics policy, dsx::stats::none (default, no cost) or
+ * dsx::stats::counting.
  */
-template <typename T> class Queue
+template <typename T, typename Stats = dsx::stats::none> class Queue
 {
   private:
     /**
@@ -41,6 +44,7 @@ template <typename T> class Queue
         }
     };
 
+    [[no_unique_address]] Stats stats_policy; ///< Allocation and operation counters.
     Node *head = nullptr; ///< Pointer to the head of the linked list.
     Node *tail = nullptr; ///< Pointer to the tail of the linked list.
     size_t len = 0;       ///< The length of the linked list.
@@ -50,7 +54,7 @@ template <typename T> class Queue
      * @brief Default constructor for Queue.
      * Initializes an empty linked list.
      */
-    Queue<T>()
+    Queue()
     {
         this->head = nullptr;
         this->tail = nullptr;
@@ -60,17 +64,20 @@ template <typename T> class Queue
      * @brief Constructor for Queue with a single element.
      * @param item The element to initialize the list with.
      */
-    Queue<T>(T item)
+    Queue(T item)
     {
         this->head = new Node(item);
         this->tail = this->head;
+        ++this->len;
+        this->stats_policy.on_alloc(1, sizeof(Node));
+        this->stats_policy.on_size(this->len, this->len);
     }
 
     /**
      * @brief Constructor for Queue using an initializer list.
      * @param list The initializer list to initialize the list with.
      */
-    Queue<T>(std::initializer_list<T> list)
+    Queue(std::initializer_list<T> list)
     {
         for (const T &item : list)
         {
@@ -78,6 +85,24 @@ template <typename T> class Queue
         }
     }
 
+    /**
+     * @brief Destructor for Queue.
+     * Releases every node still in the list.
+     */
+    ~Queue()
+    {
+        while (this->tail)
+        {
+            Node *prev = this->tail->prev;
+            delete this->tail;
+            this->stats_policy.on_free();
+            this->tail = prev;
+        }
+    }
+
+    Queue(const Queue &) = delete;
+    Queue &operator=(const Queue &) = delete;
+
     /**
      * @brief Get the length of the linked list.
      * @return The length of the linked list.
@@ -96,6 +121,16 @@ template <typename T> class Queue
         return this->head == nullptr;
     }
 
+    /**
+     * @brief Get the allocation and operation statistics so far.
+     * @return A snapshot; empty with `enabled` false under dsx::stats::none.
+     * Slack is the per-node link overhead, as a list has no spare capacity.
+     */
+    dsx::stats::snapshot stats() const
+    {
+        return this->stats_policy.take(this->len, this->len, sizeof(T), sizeof(Node) - sizeof(T));
+    }
+
     /**
      * @brief Add an element to the end of the linked list.
      * @param item The element to be added.
@@ -112,9 +147,12 @@ template <typename T> class Queue
         else
         {
             node->prev = this->tail;
+            this->tail->next = node;
             this->tail = node;
         }
         ++this->len;
+        this->stats_policy.on_alloc(1, sizeof(Node));
+        this->stats_policy.on_size(this->len, this->len);
     }
 
     /**
@@ -149,8 +187,19 @@ template <typename T> class Queue
             throw std::runtime_error(ss.str());
         }
 
-        T item = this->tail->val;
-        this->tail = this->tail->prev;
+        Node *node = this->tail;
+        T item = node->val;
+        this->tail = node->prev;
+        if (this->tail)
+        {
+            this->tail->next = nullptr;
+        }
+        else
+        {
+            this->head = nullptr;
+        }
+        delete node;
+        this->stats_policy.on_free();
         --this->len;
         return item;
     }
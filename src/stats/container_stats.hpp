@@ -0,0 +1,142 @@
+/**
+ * @file container_stats.hpp
+ * @brief Opt-in allocation and operation statistics policies for the dsx
+ * containers.
+ */
+
+#ifndef LIBDSX_CONTAINER_STATS_H
+#define LIBDSX_CONTAINER_STATS_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace dsx::stats
+{
+/**
+ * @brief Point-in-time copy of a container's statistics.
+ */
+struct snapshot
+{
+    bool enabled = false;           ///< False when the container was built with stats::none.
+    std::uint64_t allocations = 0;  ///< Buffers or nodes allocated.
+    std::uint64_t deallocations = 0; ///< Buffers or nodes released.
+    std::uint64_t growth_events = 0; ///< Reallocations caused by running out of capacity.
+    std::uint64_t elements_copied = 0; ///< Elements copied or moved by reallocations and shifts.
+    std::uint64_t bytes_copied = 0;
+    int peak_len = 0;
+    int peak_capacity = 0;
+    int len = 0;               ///< Length when the snapshot was taken.
+    int capacity = 0;          ///< Capacity when the snapshot was taken.
+    int slack = 0;             ///< capacity - len, in elements.
+    std::uint64_t slack_bytes = 0; ///< Memory held but not storing elements, including per-node overhead.
+};
+
+/**
+ * @brief Writes a snapshot as a single-line JSON object.
+ */
+inline std::ostream &operator<<(std::ostream &out, const snapshot &snap)
+{
+    return out << "{\"enabled\": " << (snap.enabled ? "true" : "false") << ", \"allocations\": " << snap.allocations
+               << ", \"deallocations\": " << snap.deallocations << ", \"growth_events\": " << snap.growth_events
+               << ", \"elements_copied\": " << snap.elements_copied << ", \"bytes_copied\": " << snap.bytes_copied
+               << ", \"peak_len\": " << snap.peak_len << ", \"peak_capacity\": " << snap.peak_capacity
+               << ", \"len\": " << snap.len << ", \"capacity\": " << snap.capacity << ", \"slack\": " << snap.slack
+               << ", \"slack_bytes\": " << snap.slack_bytes << "}";
+}
+
+/**
+ * @brief Default policy: every hook is an empty inline function and the
+ * object is empty, so with [[no_unique_address]] it adds neither code nor
+ * bytes to the container.
+ */
+struct none
+{
+    void on_alloc(int, std::size_t) noexcept
+    {
+    }
+    void on_free() noexcept
+    {
+    }
+    void on_growth() noexcept
+    {
+    }
+    void on_copy(int, std::size_t) noexcept
+    {
+    }
+    void on_size(int, int) noexcept
+    {
+    }
+    snapshot take(int, int, std::size_t, std::size_t) const noexcept
+    {
+        return {};
+    }
+};
+
+/**
+ * @brief Counting policy. Not synchronised, like the containers themselves.
+ */
+struct counting
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t growth_events = 0;
+    std::uint64_t elements_copied = 0;
+    std::uint64_t bytes_copied = 0;
+    int peak_len = 0;
+    int peak_capacity = 0;
+
+    void on_alloc(int, std::size_t) noexcept
+    {
+        ++allocations;
+    }
+    void on_free() noexcept
+    {
+        ++deallocations;
+    }
+    void on_growth() noexcept
+    {
+        ++growth_events;
+    }
+    void on_copy(int count, std::size_t elem_size) noexcept
+    {
+        elements_copied += count;
+        bytes_copied += static_cast<std::uint64_t>(count) * elem_size;
+    }
+    void on_size(int len, int capacity) noexcept
+    {
+        peak_len = std::max(peak_len, len);
+        peak_capacity = std::max(peak_capacity, capacity);
+    }
+
+    /**
+     * @brief Builds a snapshot from the counters and the current shape.
+     *
+     * @param len The container's current length.
+     * @param capacity The container's current capacity.
+     * @param elem_size The size of one stored element.
+     * @param overhead Extra bytes held per element (e.g. node links).
+     */
+    snapshot take(int len, int capacity, std::size_t elem_size, std::size_t overhead) const noexcept
+    {
+        snapshot snap;
+        snap.enabled = true;
+        snap.allocations = allocations;
+        snap.deallocations = deallocations;
+        snap.growth_events = growth_events;
+        snap.elements_copied = elements_copied;
+        snap.bytes_copied = bytes_copied;
+        snap.peak_len = std::max(peak_len, len);
+        snap.peak_capacity = std::max(peak_capacity, capacity);
+        snap.len = len;
+        snap.capacity = capacity;
+        snap.slack = capacity - len;
+        snap.slack_bytes = static_cast<std::uint64_t>(capacity - len) * elem_size +
+                           static_cast<std::uint64_t>(len) * overhead;
+        return snap;
+    }
+};
+
+} // namespace dsx::stats
+
+#endif // LIBDSX_CONTAINER_STATS_H
@@ -0,0 +1,561 @@
+/**
+ * @file bit_vector.hpp
+ * @brief Definition of the bit_vector class, a packed vector of booleans with
+ * word-parallel bulk operations and an optional rank/select index.
+ */
+
+#ifndef LIBDSX_BIT_VECTOR_H
+#define LIBDSX_BIT_VECTOR_H
+#include "v_exceptions.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace dsx::structs
+{
+/**
+ * @brief A vector of booleans packed 64 per word.
+ *
+ * Uses 8x less memory than dsx::structs::vector<bool>, which stores one byte
+ * per flag, and lets scans work a word at a time: count() is a popcount per
+ * word, find_first()/find_next() skip 64 clear bits per step, and the bulk
+ * and bitwise operations are plain word loops the compiler can vectorize.
+ * The CMake build passes -mpopcnt (option LIBDSX_POPCNT) so that
+ * std::popcount compiles to the POPCNT instruction.
+ *
+ * Bits past len() in the last word are always kept clear, so whole-word
+ * operations never have to mask them out on read.
+ *
+ * build_rank_index() adds a small directory (one int per 512 bits) that
+ * answers rank() in O(1) and select() in O(log n). Any modification makes the
+ * index stale until it is rebuilt.
+ */
+class bit_vector
+{
+  private:
+    static constexpr int _word_bits = 64;
+    static constexpr int _block_words = 8; ///< Words per rank directory entry.
+
+    dsx::structs::vector<std::uint64_t> _words = dsx::structs::vector<std::uint64_t>(0);
+    int _len = {0};
+    dsx::structs::vector<int> _rank_blocks = dsx::structs::vector<int>(0); ///< Set bits before each block.
+    bool _rank_valid = false;
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty bit vector.
+     */
+    bit_vector() = default;
+
+    /**
+     * @brief Constructor that creates n bits, all set to `value`.
+     */
+    explicit bit_vector(int p_size, bool value = false)
+    {
+        resize(p_size, value);
+    }
+
+    bit_vector(const bit_vector &) = delete;
+    bit_vector &operator=(const bit_vector &) = delete;
+
+  public:
+    /**
+     * @brief Get the number of bits.
+     * @return The number of bits in the vector.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _len;
+    }
+
+    /**
+     * @brief Get the number of bits that fit without reallocation.
+     * @return The current capacity in bits.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        return _words.capacity() * _word_bits;
+    }
+
+    /**
+     * @brief Check if the bit vector is empty.
+     * @return True if there are no bits, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    /**
+     * @brief Reserves memory for a given number of bits.
+     * @param n_bits The number of bits to reserve memory for.
+     */
+    void reserve(int n_bits)
+    {
+        _words.reserve(word_count(n_bits));
+    }
+
+  public:
+    /**
+     * @brief Returns the bit at the specified index.
+     *
+     * @param p_idx The index of the bit.
+     * @return The value of the bit.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    [[nodiscard]] bool at(int p_idx) const
+    {
+        check_index(p_idx);
+        return (_words.data()[p_idx / _word_bits] >> (p_idx % _word_bits)) & 1;
+    }
+
+    /**
+     * @brief Sets the bit at the specified index to `value`.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    void set(int p_idx, bool value = true)
+    {
+        check_index(p_idx);
+        std::uint64_t bit = std::uint64_t{1} << (p_idx % _word_bits);
+        std::uint64_t &word = _words.data()[p_idx / _word_bits];
+        word = value ? word | bit : word & ~bit;
+        _rank_valid = false;
+    }
+
+    /**
+     * @brief Clears the bit at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    void reset(int p_idx)
+    {
+        set(p_idx, false);
+    }
+
+    /**
+     * @brief Inverts the bit at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    void flip(int p_idx)
+    {
+        check_index(p_idx);
+        _words.data()[p_idx / _word_bits] ^= std::uint64_t{1} << (p_idx % _word_bits);
+        _rank_valid = false;
+    }
+
+  public:
+    void push(bool value);
+    std::optional<bool> pop();
+    void resize(int n_size, bool value = false);
+    void clear();
+
+    void set_range(int begin, int end, bool value = true);
+    void flip_range(int begin, int end);
+
+    /**
+     * @brief Sets every bit.
+     */
+    void set_all()
+    {
+        set_range(0, _len, true);
+    }
+
+    /**
+     * @brief Clears every bit.
+     */
+    void reset_all()
+    {
+        set_range(0, _len, false);
+    }
+
+    /**
+     * @brief Inverts every bit.
+     */
+    void flip_all()
+    {
+        flip_range(0, _len);
+    }
+
+    [[nodiscard]] int count() const;
+    [[nodiscard]] int find_first() const;
+    [[nodiscard]] int find_next(int pos) const;
+
+    bit_vector &operator&=(const bit_vector &other);
+    bit_vector &operator|=(const bit_vector &other);
+    bit_vector &operator^=(const bit_vector &other);
+
+    void build_rank_index();
+    [[nodiscard]] int rank(int p_idx) const;
+    [[nodiscard]] int select(int k) const;
+
+  private:
+    static int word_count(int bits) noexcept
+    {
+        return (bits + _word_bits - 1) / _word_bits;
+    }
+
+    /**
+     * @brief Mask of the bits in [lo, hi) of one word, 0 <= lo <= hi <= 64.
+     */
+    static std::uint64_t range_mask(int lo, int hi) noexcept
+    {
+        std::uint64_t upper = hi == _word_bits ? ~std::uint64_t{0} : (std::uint64_t{1} << hi) - 1;
+        return upper & ~((std::uint64_t{1} << lo) - 1);
+    }
+
+    /**
+     * @brief Clears the unused bits of the last word.
+     */
+    void trim() noexcept
+    {
+        if (_len % _word_bits)
+        {
+            _words.data()[_words.len() - 1] &= range_mask(0, _len % _word_bits);
+        }
+    }
+
+    void check_index(int p_idx) const
+    {
+        if (p_idx < 0)
+        {
+            throw dsx::structs::exceptions::NegativeIndexExecption();
+        }
+
+        if (p_idx >= _len)
+        {
+            throw std::out_of_range("The index: " + std::to_string(p_idx) +
+                                    " is out of bounds of bit_vector with len " + std::to_string(this->_len));
+        }
+    }
+
+    void check_same_len(const bit_vector &other) const
+    {
+        if (other._len != _len)
+        {
+            throw std::invalid_argument("bit_vector lengths differ: " + std::to_string(_len) + " and " +
+                                        std::to_string(other._len));
+        }
+    }
+
+    void check_range(int begin, int end) const
+    {
+        if (begin < 0 || end > _len || begin > end)
+        {
+            throw std::out_of_range("The range [" + std::to_string(begin) + ", " + std::to_string(end) +
+                                    ") is out of bounds of bit_vector with len " + std::to_string(this->_len));
+        }
+    }
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Adds a bit to the end of the vector.
+ *
+ * @param value The value of the new bit.
+ */
+inline void dsx::structs::bit_vector::push(bool value)
+{
+    if (_len % _word_bits == 0)
+    {
+        _words.push(0);
+    }
+    _words.data()[_len / _word_bits] |= std::uint64_t{value} << (_len % _word_bits);
+    ++_len;
+    _rank_valid = false;
+}
+
+/**
+ * @brief Removes and returns the last bit.
+ *
+ * @return An optional containing the last bit, or an empty optional if the
+ * vector is empty.
+ */
+inline std::optional<bool> dsx::structs::bit_vector::pop()
+{
+    if (is_empty())
+    {
+        return std::nullopt;
+    }
+
+    bool popped = at(_len - 1);
+    --_len;
+    _words.resize(word_count(_len));
+    trim();
+    _rank_valid = false;
+    return popped;
+}
+
+/**
+ * @brief Resizes the vector to n_size bits; new bits are set to `value`.
+ */
+inline void dsx::structs::bit_vector::resize(int n_size, bool value)
+{
+    int old_len = _len;
+    _words.resize(word_count(n_size));
+    _len = n_size;
+    if (n_size > old_len && value)
+    {
+        set_range(old_len, n_size, true);
+    }
+    trim();
+    _rank_valid = false;
+}
+
+/**
+ * @brief Removes all bits.
+ */
+inline void dsx::structs::bit_vector::clear()
+{
+    _words.resize(0);
+    _len = 0;
+    _rank_valid = false;
+}
+
+/**
+ * @brief Sets or clears every bit in [begin, end), a word at a time.
+ * @throws std::out_of_range If the range is out of bounds.
+ */
+inline void dsx::structs::bit_vector::set_range(int begin, int end, bool value)
+{
+    check_range(begin, end);
+    std::uint64_t *words = _words.data();
+    while (begin < end)
+    {
+        int lo = begin % _word_bits;
+        int hi = std::min(_word_bits, lo + (end - begin));
+        std::uint64_t mask = range_mask(lo, hi);
+        std::uint64_t &word = words[begin / _word_bits];
+        word = value ? word | mask : word & ~mask;
+        begin += hi - lo;
+    }
+    _rank_valid = false;
+}
+
+/**
+ * @brief Inverts every bit in [begin, end), a word at a time.
+ * @throws std::out_of_range If the range is out of bounds.
+ */
+inline void dsx::structs::bit_vector::flip_range(int begin, int end)
+{
+    check_range(begin, end);
+    std::uint64_t *words = _words.data();
+    while (begin < end)
+    {
+        int lo = begin % _word_bits;
+        int hi = std::min(_word_bits, lo + (end - begin));
+        words[begin / _word_bits] ^= range_mask(lo, hi);
+        begin += hi - lo;
+    }
+    _rank_valid = false;
+}
+
+/**
+ * @brief Counts the set bits.
+ */
+inline int dsx::structs::bit_vector::count() const
+{
+    const std::uint64_t *words = _words.data();
+    int n = _words.len();
+    int total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        total += std::popcount(words[i]);
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the index of the first set bit, or -1 if there is none.
+ */
+inline int dsx::structs::bit_vector::find_first() const
+{
+    return find_next(-1);
+}
+
+/**
+ * @brief Returns the index of the first set bit after `pos`, or -1.
+ *
+ * @param pos The position to search after; -1 searches from the start.
+ * @throws dsx::structs::exceptions::NegativeIndexExecption If pos is below -1.
+ */
+inline int dsx::structs::bit_vector::find_next(int pos) const
+{
+    if (pos < -1)
+    {
+        throw dsx::structs::exceptions::NegativeIndexExecption();
+    }
+
+    int start = pos + 1;
+    if (start >= _len)
+    {
+        return -1;
+    }
+
+    const std::uint64_t *words = _words.data();
+    int w = start / _word_bits;
+    std::uint64_t word = words[w] & ~((std::uint64_t{1} << (start % _word_bits)) - 1);
+    int n = _words.len();
+    while (word == 0)
+    {
+        if (++w == n)
+        {
+            return -1;
+        }
+        word = words[w];
+    }
+    return w * _word_bits + std::countr_zero(word);
+}
+
+inline dsx::structs::bit_vector &dsx::structs::bit_vector::operator&=(const bit_vector &other)
+{
+    check_same_len(other);
+    std::uint64_t *words = _words.data();
+    const std::uint64_t *rhs = other._words.data();
+    for (int i = 0, n = _words.len(); i < n; i++)
+    {
+        words[i] &= rhs[i];
+    }
+    _rank_valid = false;
+    return *this;
+}
+
+inline dsx::structs::bit_vector &dsx::structs::bit_vector::operator|=(const bit_vector &other)
+{
+    check_same_len(other);
+    std::uint64_t *words = _words.data();
+    const std::uint64_t *rhs = other._words.data();
+    for (int i = 0, n = _words.len(); i < n; i++)
+    {
+        words[i] |= rhs[i];
+    }
+    _rank_valid = false;
+    return *this;
+}
+
+inline dsx::structs::bit_vector &dsx::structs::bit_vector::operator^=(const bit_vector &other)
+{
+    check_same_len(other);
+    std::uint64_t *words = _words.data();
+    const std::uint64_t *rhs = other._words.data();
+    for (int i = 0, n = _words.len(); i < n; i++)
+    {
+        words[i] ^= rhs[i];
+    }
+    _rank_valid = false;
+    return *this;
+}
+
+/**
+ * @brief Builds the rank/select directory for the current contents.
+ */
+inline void dsx::structs::bit_vector::build_rank_index()
+{
+    const std::uint64_t *words = _words.data();
+    int n = _words.len();
+    _rank_blocks.resize(n / _block_words + 1);
+
+    int total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (i % _block_words == 0)
+        {
+            _rank_blocks.data()[i / _block_words] = total;
+        }
+        total += std::popcount(words[i]);
+    }
+    if (n % _block_words == 0)
+    {
+        _rank_blocks.data()[n / _block_words] = total; // Sentinel block that starts at the end
+    }
+    _rank_valid = true;
+}
+
+/**
+ * @brief Counts the set bits in [0, p_idx).
+ *
+ * @param p_idx A position in [0, len()].
+ * @throws std::logic_error If the index was not built or is stale.
+ */
+inline int dsx::structs::bit_vector::rank(int p_idx) const
+{
+    if (!_rank_valid)
+    {
+        throw std::logic_error("bit_vector rank index is stale, call build_rank_index()");
+    }
+    if (p_idx < 0 || p_idx > _len)
+    {
+        throw std::out_of_range("rank position " + std::to_string(p_idx) + " is out of bounds of bit_vector with len " +
+                                std::to_string(this->_len));
+    }
+
+    const std::uint64_t *words = _words.data();
+    int w = p_idx / _word_bits;
+    int total = _rank_blocks.data()[w / _block_words];
+    for (int i = w - w % _block_words; i < w; i++)
+    {
+        total += std::popcount(words[i]);
+    }
+    if (p_idx % _word_bits)
+    {
+        total += std::popcount(words[w] & range_mask(0, p_idx % _word_bits));
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the position of the k-th set bit (0-based), or -1 if there
+ * are not that many.
+ *
+ * @throws std::logic_error If the index was not built or is stale.
+ */
+inline int dsx::structs::bit_vector::select(int k) const
+{
+    if (!_rank_valid)
+    {
+        throw std::logic_error("bit_vector rank index is stale, call build_rank_index()");
+    }
+    if (k < 0)
+    {
+        return -1;
+    }
+
+    // Last block whose preceding count is <= k
+    const int *blocks = _rank_blocks.data();
+    int lo = 0, hi = _rank_blocks.len() - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (blocks[mid] <= k)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    const std::uint64_t *words = _words.data();
+    int remaining = k - blocks[lo];
+    for (int w = lo * _block_words, n = _words.len(); w < n; w++)
+    {
+        int ones = std::popcount(words[w]);
+        if (remaining < ones)
+        {
+            std::uint64_t word = words[w];
+            for (int i = 0; i < remaining; i++)
+            {
+                word &= word - 1; // Drop the lowest set bit
+            }
+            return w * _word_bits + std::countr_zero(word);
+        }
+        remaining -= ones;
+    }
+    return -1;
+}
+
+#endif // LIBDSX_BIT_VECTOR_H
@@ -0,0 +1,388 @@
+/**
+ * @file concurrent_vector.hpp
+ * @brief Definition of the concurrent_vector class, an append-only vector
+ * that many threads can push to at the same time.
+ */
+
+#ifndef LIBDSX_CONCURRENT_VECTOR_H
+#define LIBDSX_CONCURRENT_VECTOR_H
+#include "v_exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dsx::structs
+{
+/**
+ * @brief A segmented, append-only vector with lock-free push.
+ *
+ * Storage is a fixed table of segments whose sizes double: segment 0 holds
+ * `FirstSegment` elements, segment 1 twice as many, and so on. Growing only
+ * ever adds a segment, so elements never move and an index handed out by
+ * push() stays valid for the lifetime of the container.
+ *
+ * push() claims an index with a compare-and-swap on the claimed count and
+ * installs a missing segment with another; the thread that loses the install
+ * race frees its segment and uses the winner's. No operation takes a lock.
+ *
+ * A segment is one raw allocation: a ready bitmap with one bit per slot,
+ * followed by uninitialized storage for the elements. push() copy-constructs
+ * its element in place and then sets its bit, so installing a segment (and
+ * losing the race to install one) only costs zeroing the bitmap.
+ *
+ * A separate committed size covers the longest prefix of ready slots; after
+ * setting its bit, each push advances it over every ready slot it finds, so the
+ * last writer of a prefix always publishes it and nobody waits for a slower
+ * writer. len(), at() and operator[] check against the committed size with
+ * acquire loads, so any index below len() is fully written and may be read
+ * while other threads keep pushing.
+ *
+ * @tparam T The type of elements held in the vector. Must be copy
+ * constructible.
+ * @tparam FirstSegment The size of the first segment. Must be a power of two.
+ */
+template <typename T, int FirstSegment = 32> class concurrent_vector
+{
+    static_assert(FirstSegment > 0 && std::has_single_bit(static_cast<unsigned>(FirstSegment)),
+                  "concurrent_vector: FirstSegment must be a power of two");
+
+  private:
+    using word = std::atomic<std::uint64_t>; ///< One bitmap word, 64 ready bits.
+
+    static constexpr int _first_shift = std::bit_width(static_cast<unsigned>(FirstSegment)) - 1;
+    static constexpr int _max_segments = 31 - _first_shift; ///< Enough segments to cover every positive int index.
+    static constexpr int _max_index = std::numeric_limits<int>::max() - FirstSegment; ///< Last index split() maps.
+    static constexpr std::align_val_t _align{std::max(alignof(T), alignof(word))};
+
+    std::atomic<std::byte *> _segments[_max_segments] = {};
+    std::atomic<int> _claimed = {0};   ///< Indices handed out by push().
+    std::atomic<int> _committed = {0}; ///< Prefix of indices whose element is written.
+
+  public:
+    /**
+     * @brief Default constructor, no segment is allocated until the first push.
+     */
+    concurrent_vector() = default;
+
+    /**
+     * @brief Constructor that preallocates segments for the given capacity.
+     * @param p_size The number of elements to make room for.
+     */
+    explicit concurrent_vector(int p_size)
+    {
+        reserve(p_size);
+    }
+
+    concurrent_vector(const concurrent_vector &) = delete;
+    concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+    /**
+     * @brief Destructor, destroys every constructed element and releases every
+     * allocated segment.
+     *
+     * Must not run concurrently with any other operation.
+     */
+    ~concurrent_vector()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            int claimed = _claimed.load(std::memory_order_relaxed);
+            for (int idx = 0; idx < claimed; idx++)
+            {
+                // A push whose copy constructor threw never set its bit
+                if (is_ready(idx))
+                {
+                    std::destroy_at(&locate(idx));
+                }
+            }
+        }
+        for (auto &segment : _segments)
+        {
+            ::operator delete(segment.load(std::memory_order_relaxed), _align);
+        }
+    }
+
+  public:
+    /**
+     * @brief Get the number of published elements.
+     *
+     * Every index below the returned value is written and safe to read, even
+     * while other pushes are in flight.
+     *
+     * @return The number of elements in the vector.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _committed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the number of elements the allocated segments can hold.
+     * @return The current capacity of the vector.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        int cap = 0;
+        for (int k = 0; k < _max_segments && _segments[k].load(std::memory_order_acquire); k++)
+        {
+            cap += segment_size(k);
+        }
+        return cap;
+    }
+
+    /**
+     * @brief Check if the vector is empty.
+     * @return True if the vector is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    void reserve(int n_size);
+
+  public:
+    /**
+     * @brief Returns the element at the specified index.
+     *
+     * @param p_idx The index of the element to access.
+     * @return The element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T at(int p_idx) const
+    {
+        check_index(p_idx);
+        return locate(p_idx);
+    }
+
+    /**
+     * @brief Returns a reference to the element at the specified index.
+     *
+     * The reference stays valid for the lifetime of the vector.
+     *
+     * @param p_idx The index of the element to access.
+     * @return A reference to the element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T &operator[](int p_idx) const noexcept(false)
+    {
+        check_index(p_idx);
+        return locate(p_idx);
+    }
+
+  public:
+    int push(const T &elt);
+
+  private:
+    static constexpr int segment_size(int k) noexcept
+    {
+        return FirstSegment << k;
+    }
+
+    /**
+     * @brief Maps an index to its segment and the offset inside it.
+     *
+     * Segment k starts at index FirstSegment * (2^k - 1), so shifting the index
+     * by FirstSegment turns the segment number into a bit width.
+     */
+    static constexpr void split(int p_idx, int &segment, int &offset) noexcept
+    {
+        unsigned shifted = static_cast<unsigned>(p_idx) + FirstSegment;
+        segment = std::bit_width(shifted) - 1 - _first_shift;
+        offset = static_cast<int>(shifted - (static_cast<unsigned>(FirstSegment) << segment));
+    }
+
+    static constexpr std::size_t bitmap_words(int k) noexcept
+    {
+        return (static_cast<std::size_t>(segment_size(k)) + 63) / 64;
+    }
+
+    /**
+     * @brief Byte offset of the element storage, the bitmap rounded up to the
+     * alignment of T.
+     */
+    static constexpr std::size_t values_offset(int k) noexcept
+    {
+        std::size_t align = static_cast<std::size_t>(_align);
+        return (bitmap_words(k) * sizeof(word) + align - 1) / align * align;
+    }
+
+    static constexpr std::uint64_t bit(int offset) noexcept
+    {
+        return std::uint64_t{1} << (offset % 64);
+    }
+
+    static word *bits(std::byte *base) noexcept
+    {
+        return std::launder(reinterpret_cast<word *>(base));
+    }
+
+    static T *values(std::byte *base, int k) noexcept
+    {
+        return reinterpret_cast<T *>(base + values_offset(k));
+    }
+
+    T &locate(int p_idx) const noexcept
+    {
+        int segment, offset;
+        split(p_idx, segment, offset);
+        return *std::launder(values(_segments[segment].load(std::memory_order_acquire), segment) + offset);
+    }
+
+    /**
+     * @brief Checks a claimed slot's ready bit; a segment that is not
+     * installed yet means the slot is not ready.
+     */
+    bool is_ready(int p_idx) const noexcept
+    {
+        int segment, offset;
+        split(p_idx, segment, offset);
+        std::byte *base = _segments[segment].load(std::memory_order_seq_cst);
+        return base && (bits(base)[offset / 64].load(std::memory_order_seq_cst) & bit(offset));
+    }
+
+    std::byte *ensure_segment(int k);
+    int claim();
+    void publish();
+
+    void check_index(int p_idx) const
+    {
+        if (p_idx < 0)
+        {
+            throw dsx::structs::exceptions::NegativeIndexExecption();
+        }
+
+        if (p_idx >= len())
+        {
+            throw std::out_of_range("The index: " + std::to_string(p_idx) + " is out of bounds of vector with len " +
+                                    std::to_string(len()));
+        }
+    }
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Returns segment k, allocating and publishing it if needed.
+ *
+ * Only the ready bitmap is initialized; the element storage stays raw until
+ * each push constructs its element. Several threads may race to allocate the
+ * same segment; only one compare-and-swap succeeds and the others free their
+ * block without having constructed anything in it.
+ */
+template <typename T, int FirstSegment>
+std::byte *dsx::structs::concurrent_vector<T, FirstSegment>::ensure_segment(int k)
+{
+    std::byte *segment = _segments[k].load(std::memory_order_acquire);
+    if (segment)
+    {
+        return segment;
+    }
+
+    std::size_t bytes = values_offset(k) + static_cast<std::size_t>(segment_size(k)) * sizeof(T);
+    auto *fresh = static_cast<std::byte *>(::operator new(bytes, _align));
+    std::uninitialized_value_construct_n(reinterpret_cast<word *>(fresh), bitmap_words(k));
+    if (_segments[k].compare_exchange_strong(segment, fresh, std::memory_order_seq_cst, std::memory_order_acquire))
+    {
+        return fresh;
+    }
+
+    ::operator delete(fresh, _align); // Another thread installed the segment first
+    return segment;
+}
+
+/**
+ * @brief Allocates every segment needed to hold n_size elements.
+ *
+ * Safe to call concurrently with push().
+ *
+ * @param n_size The number of elements to reserve memory for.
+ */
+template <typename T, int FirstSegment> void dsx::structs::concurrent_vector<T, FirstSegment>::reserve(int n_size)
+{
+    if (n_size <= 0)
+    {
+        return;
+    }
+
+    int last, offset;
+    split(n_size - 1, last, offset);
+    for (int k = 0; k <= last; k++)
+    {
+        ensure_segment(k);
+    }
+}
+
+/**
+ * @brief Claims the next index, refusing to count past the last one a segment
+ * can hold so the claimed count never overflows.
+ *
+ * @throws std::length_error If every segment is full.
+ */
+template <typename T, int FirstSegment> int dsx::structs::concurrent_vector<T, FirstSegment>::claim()
+{
+    int idx = _claimed.load(std::memory_order_relaxed);
+    do
+    {
+        if (idx > _max_index)
+        {
+            throw std::length_error("concurrent_vector is full");
+        }
+    } while (!_claimed.compare_exchange_weak(idx, idx + 1, std::memory_order_relaxed));
+    return idx;
+}
+
+/**
+ * @brief Appends an element and returns its index.
+ *
+ * Lock-free: the index is claimed and a missing segment is installed with
+ * compare-and-swaps, and the committed size is advanced with compare-and-swaps;
+ * no push waits for another.
+ *
+ * @param elt The element to be added to the end of the vector.
+ * @return The index of the new element.
+ * @throws std::length_error If every segment is full.
+ */
+template <typename T, int FirstSegment> int dsx::structs::concurrent_vector<T, FirstSegment>::push(const T &elt)
+{
+    int idx = claim();
+
+    int segment, offset;
+    split(idx, segment, offset);
+    std::byte *base = ensure_segment(segment);
+    std::construct_at(values(base, segment) + offset, elt);
+    bits(base)[offset / 64].fetch_or(bit(offset), std::memory_order_seq_cst);
+    publish();
+
+    return idx;
+}
+
+/**
+ * @brief Advances the committed size over every ready slot.
+ *
+ * A writer that finds an earlier slot not ready yet stops. Ready bits and
+ * segment installs are seq_cst, so that earlier writer then sees this slot
+ * ready when it runs publish() itself, and the prefix is never left behind.
+ */
+template <typename T, int FirstSegment> void dsx::structs::concurrent_vector<T, FirstSegment>::publish()
+{
+    int committed = _committed.load(std::memory_order_acquire);
+    while (committed < _claimed.load(std::memory_order_relaxed) && is_ready(committed))
+    {
+        // On failure committed is reloaded and the loop checks the new slot
+        if (_committed.compare_exchange_weak(committed, committed + 1, std::memory_order_acq_rel))
+        {
+            ++committed;
+        }
+    }
+}
+
+#endif // LIBDSX_CONCURRENT_VECTOR_H
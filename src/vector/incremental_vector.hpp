@@ -0,0 +1,412 @@
+/**
+ * @file incremental_vector.hpp
+ * @brief Definition of the incremental_vector class, a vector that spreads the
+ * cost of growing over many operations.
+ */
+
+#ifndef LIBDSX_INCREMENTAL_VECTOR_H
+#define LIBDSX_INCREMENTAL_VECTOR_H
+#include "v_exceptions.hpp"
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dsx::structs
+{
+/**
+ * @brief A dynamic array with amortized-migration (real-time) growth.
+ *
+ * Where dsx::structs::vector copies every element into the new array the moment
+ * it runs out of room, incremental_vector keeps both the old and the new array
+ * alive after growing and moves at most `Step` elements from the old one to the
+ * new one on every subsequent push, pop or mutable access. Since the new array
+ * is twice as large, the migration is always finished before it fills up, so no
+ * single operation ever does O(n) copying.
+ *
+ * Both arrays are raw storage: growing allocates without constructing anything,
+ * each migrated element is move-constructed into the new array and destroyed in
+ * the old one, and the drained old array is freed without touching an element.
+ *
+ * While a migration is in flight the elements in [_migrated, _old_len) still
+ * live in the old array, every other element lives in the new one. Slots
+ * outside those ranges hold no object.
+ *
+ * @tparam T The type of elements held in the vector.
+ * @tparam Step The maximum number of elements migrated per operation. Must be
+ * at least 1.
+ */
+template <typename T, int Step = 4> class incremental_vector
+{
+    static_assert(Step >= 1, "incremental_vector must migrate at least one element per operation");
+
+  private:
+    int _cap = 5;
+    T *_arr = allocate(_cap);
+    int _len = {0};
+
+    T *_old = nullptr; ///< Array being drained, nullptr when no migration is in flight.
+    int _old_len = {0}; ///< Number of elements that were in the old array when growing.
+    int _migrated = {0}; ///< Number of elements already moved to the new array.
+    int _old_cap = {0}; ///< Capacity of the old array, needed to free it.
+
+  public:
+    /**
+     * @brief Default constructor for the incremental_vector class.
+     *
+     * Creates an empty vector with the default initial capacity.
+     */
+    incremental_vector() = default;
+
+    /**
+     * @brief Constructor that sets the initial capacity of the vector.
+     *
+     * @param p_size The initial capacity of the vector.
+     */
+    explicit incremental_vector(int p_size)
+    {
+        release(_arr, _cap);
+        _cap = std::max(p_size, 1);
+        _arr = allocate(_cap);
+    }
+
+    incremental_vector(const incremental_vector &) = delete;
+    incremental_vector &operator=(const incremental_vector &) = delete;
+
+    /**
+     * @brief Destructor, releases both the current and the draining array.
+     */
+    ~incremental_vector()
+    {
+        clear();
+        release(_arr, _cap);
+    }
+
+  public:
+    /**
+     * @brief Get the current number of elements in the vector.
+     * @return The number of elements in the vector.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _len;
+    }
+
+    /**
+     * @brief Get the capacity of the current (newest) array.
+     * @return The current capacity of the vector.
+     */
+    [[nodiscard]] int capacity() const
+    {
+        return _cap;
+    }
+
+    /**
+     * @brief Check if the vector is empty.
+     * @return True if the vector is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    /**
+     * @brief Check if elements are still being moved out of an old array.
+     * @return True while a migration is in flight.
+     */
+    [[nodiscard]] bool is_migrating() const
+    {
+        return _old != nullptr;
+    }
+
+    void reserve(int n_size);
+    void finish_migration();
+
+  public:
+    /**
+     * @brief Returns the element at the specified index.
+     *
+     * This accessor is const and never advances a pending migration.
+     *
+     * @param p_idx The index of the element to access.
+     * @return The element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T at(int p_idx) const
+    {
+        check_index(p_idx);
+        return slot(p_idx);
+    }
+
+    /**
+     * @brief Returns a reference to the element at the specified index.
+     *
+     * Advances a pending migration by up to `Step` elements before resolving
+     * the index. The returned reference is invalidated by the next mutable
+     * operation if the element still lived in the old array.
+     *
+     * @param p_idx The index of the element to access.
+     * @return A reference to the element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T &operator[](int p_idx) noexcept(false)
+    {
+        check_index(p_idx);
+        migrate_step();
+        return slot(p_idx);
+    }
+
+    /**
+     * @brief Returns a reference to the first element in the vector.
+     *
+     * Calling this function on an empty vector results in undefined behavior.
+     */
+    const T &front() const noexcept
+    {
+        return slot(0);
+    }
+
+    /**
+     * @brief Returns a reference to the last element in the vector.
+     *
+     * Calling this function on an empty vector results in undefined behavior.
+     */
+    const T &back() const noexcept
+    {
+        return slot(_len - 1);
+    }
+
+  public:
+    void push(const T &elt);
+    std::optional<T> pop();
+    void clear();
+
+  private:
+    static T *allocate(int n)
+    {
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    static void release(T *arr, int n) noexcept
+    {
+        if (arr)
+        {
+            std::allocator<T>{}.deallocate(arr, n);
+        }
+    }
+
+    /**
+     * @brief Frees the drained old array; no element is left in it.
+     */
+    void drop_old() noexcept
+    {
+        release(_old, _old_cap);
+        _old = nullptr;
+        _old_cap = 0;
+        _old_len = 0;
+        _migrated = 0;
+    }
+
+    /**
+     * @brief Resolves an index to the array currently holding it.
+     */
+    T &slot(int p_idx) const noexcept
+    {
+        if (_old && p_idx >= _migrated && p_idx < _old_len)
+        {
+            return _old[p_idx];
+        }
+        return _arr[p_idx];
+    }
+
+    void check_index(int p_idx) const
+    {
+        if (p_idx < 0)
+        {
+            throw dsx::structs::exceptions::NegativeIndexExecption();
+        }
+
+        if (p_idx >= _len)
+        {
+            throw std::out_of_range("The index: " + std::to_string(p_idx) + " is out of bounds of vector with len " +
+                                    std::to_string(this->_len));
+        }
+    }
+
+    void migrate_step();
+    void grow();
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Moves up to `Step` elements from the old array to the new one.
+ *
+ * Each element is move-constructed in place and destroyed in the old array, so
+ * the old array is freed in O(1) once the last element has been moved.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::migrate_step()
+{
+    if (!_old)
+    {
+        return;
+    }
+
+    int end = std::min(_migrated + Step, _old_len);
+    for (; _migrated < end; _migrated++)
+    {
+        std::construct_at(_arr + _migrated, std::move(_old[_migrated]));
+        std::destroy_at(_old + _migrated);
+    }
+
+    if (_migrated == _old_len)
+    {
+        drop_old();
+    }
+}
+
+/**
+ * @brief Completes a pending migration in one go.
+ *
+ * This is O(n) and is meant for points where latency does not matter, e.g.
+ * before handing the vector to a bulk reader.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::finish_migration()
+{
+    if (!_old)
+    {
+        return;
+    }
+
+    std::uninitialized_move(_old + _migrated, _old + _old_len, _arr + _migrated);
+    std::destroy(_old + _migrated, _old + _old_len);
+    drop_old();
+}
+
+/**
+ * @brief Doubles the capacity without copying or constructing any element.
+ *
+ * The current array becomes the old array and will be drained by subsequent
+ * operations. Only called when no migration is in flight.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::grow()
+{
+    T *new_arr = allocate(_cap * 2);
+
+    _old = _arr;
+    _old_cap = _cap;
+    _old_len = _len;
+    _migrated = 0;
+    _arr = new_arr;
+    _cap *= 2;
+}
+
+/**
+ * @brief Reserves memory for a given number of elements in the vector.
+ *
+ * Unlike growth triggered by push, an explicit reserve copies eagerly: any
+ * pending migration is completed first, then the elements are moved to the new
+ * array.
+ *
+ * @param n_size The number of elements to reserve memory for.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::reserve(int n_size)
+{
+    if (n_size <= _cap)
+    {
+        return;
+    }
+
+    finish_migration();
+
+    T *new_arr = allocate(n_size);
+    std::uninitialized_move(_arr, _arr + _len, new_arr);
+    std::destroy(_arr, _arr + _len);
+    release(_arr, _cap);
+    _arr = new_arr;
+    _cap = n_size;
+}
+
+/**
+ * @brief Adds an element to the end of the vector.
+ *
+ * If the current array is full a new array of twice the size is allocated and
+ * the element is written there right away; the existing elements follow over
+ * the next pushes.
+ *
+ * @param elt The element to be added to the end of the vector.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::push(const T &elt)
+{
+    if (_len == _cap)
+    {
+        // Every push and pop migrates at least one element and the new array
+        // has room for as many pushes as there are old elements, so this never
+        // has anything left to move; it only keeps grow()'s precondition.
+        finish_migration();
+        grow();
+    }
+    migrate_step();
+
+    std::construct_at(_arr + _len, elt);
+    _len++;
+}
+
+/**
+ * @brief Removes and returns the last element of the vector.
+ *
+ * @return An optional containing the last element of the vector if the vector
+ * is not empty, or an empty optional if the vector is empty.
+ */
+template <typename T, int Step> std::optional<T> dsx::structs::incremental_vector<T, Step>::pop()
+{
+    if (is_empty())
+    {
+        return std::nullopt;
+    }
+
+    migrate_step();
+
+    T &last = slot(_len - 1);
+    std::optional<T> popped = std::move(last);
+    std::destroy_at(&last);
+    --_len;
+
+    if (_old && _len < _old_len)
+    {
+        // The popped element was still waiting in the old array
+        _old_len = _len;
+        if (_migrated >= _old_len)
+        {
+            drop_old();
+        }
+    }
+
+    return popped;
+}
+
+/**
+ * @brief Removes all elements from the vector, keeping the current capacity.
+ *
+ * Destroys every element (nothing to do for trivially destructible types) and
+ * frees a pending old array without reallocating the current one.
+ */
+template <typename T, int Step> void dsx::structs::incremental_vector<T, Step>::clear()
+{
+    if (_old)
+    {
+        std::destroy(_arr, _arr + _migrated);
+        std::destroy(_old + _migrated, _old + _old_len);
+        std::destroy(_arr + _old_len, _arr + _len);
+        drop_old();
+    }
+    else
+    {
+        std::destroy(_arr, _arr + _len);
+    }
+    _len = 0;
+}
+
+#endif // LIBDSX_INCREMENTAL_VECTOR_H
@@ -0,0 +1,639 @@
+/**
+ * @file persistent_vector.hpp
+ * @brief Definition of the persistent_vector class, an immutable vector whose
+ * versions share structure, and of its transient (batch-edit) counterpart.
+ */
+
+#ifndef LIBDSX_PERSISTENT_VECTOR_H
+#define LIBDSX_PERSISTENT_VECTOR_H
+#include "v_exceptions.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dsx::structs
+{
+/**
+ * @brief An immutable vector stored as a 32-way radix-balanced trie.
+ *
+ * Every update (push, set, pop) leaves the vector untouched and returns a new
+ * version that shares all but O(log32 n) nodes with it. Copying a version is
+ * O(1), which makes it a cheap snapshot: a reader can keep iterating an old
+ * copy without locks while a writer produces newer ones.
+ *
+ * The last (up to) 32 elements live in a separate tail leaf, so most pushes
+ * only copy the tail instead of walking the trie.
+ *
+ * For batches of updates, transient() returns a transient_vector that mutates
+ * nodes it has already copied in place, and persistent() turns it back into an
+ * immutable version in O(1).
+ *
+ * @tparam T The type of elements held in the vector. Must be default
+ * constructible and copyable.
+ */
+template <typename T> class persistent_vector
+{
+  private:
+    static constexpr int _bits = 5;
+    static constexpr int _width = 1 << _bits;
+    static constexpr int _mask = _width - 1;
+
+    /**
+     * @brief Node tags: 0 for nodes that belong to a persistent version, the
+     * id of the owning transient otherwise.
+     */
+    using edit_t = std::uint64_t;
+
+    struct leaf
+    {
+        edit_t edit = 0;
+        std::array<T, _width> vals{};
+    };
+
+    struct branch
+    {
+        edit_t edit = 0;
+        std::array<std::shared_ptr<void>, _width> kids{}; ///< Branches above level 5, leaves at level 5.
+    };
+
+    int _len = {0};
+    int _shift = {_bits};
+    std::shared_ptr<branch> _root = std::make_shared<branch>();
+    std::shared_ptr<leaf> _tail = std::make_shared<leaf>();
+
+    /**
+     * @brief Adopts an existing trie and tail, used to freeze a transient
+     * without allocating an empty root and tail first.
+     */
+    persistent_vector(int len, int shift, std::shared_ptr<branch> root, std::shared_ptr<leaf> tail) noexcept
+        : _len(len), _shift(shift), _root(std::move(root)), _tail(std::move(tail))
+    {
+    }
+
+  public:
+    class transient_vector;
+
+    /**
+     * @brief Default constructor, creates an empty vector.
+     */
+    persistent_vector() = default;
+
+    /**
+     * @brief Constructor that builds a vector from an initializer list.
+     *
+     * Uses a transient internally, so building costs no more than n pushes on
+     * a mutable vector.
+     *
+     * @param list The elements to store in the vector.
+     */
+    persistent_vector(std::initializer_list<T> list)
+    {
+        auto batch = transient();
+        for (const T &item : list)
+        {
+            batch.push(item);
+        }
+        *this = batch.persistent();
+    }
+
+  public:
+    /**
+     * @brief Get the number of elements in this version.
+     * @return The number of elements in the vector.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _len;
+    }
+
+    /**
+     * @brief Check if the vector is empty.
+     * @return True if the vector is empty, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return len() == 0;
+    }
+
+    /**
+     * @brief Returns the element at the specified index.
+     *
+     * @param p_idx The index of the element to access.
+     * @return The element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T at(int p_idx) const
+    {
+        return (*this)[p_idx];
+    }
+
+    /**
+     * @brief Returns a reference to the element at the specified index.
+     *
+     * The reference stays valid as long as any version sharing the element is
+     * alive.
+     *
+     * @param p_idx The index of the element to access.
+     * @return A const reference to the element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    const T &operator[](int p_idx) const noexcept(false)
+    {
+        check_index(p_idx, _len);
+        return leaf_for(_root, _tail, _shift, _len, p_idx)->vals[p_idx & _mask];
+    }
+
+    /**
+     * @brief Returns a reference to the last element in the vector.
+     *
+     * Calling this function on an empty vector results in undefined behavior.
+     */
+    const T &back() const noexcept
+    {
+        return _tail->vals[(_len - 1) & _mask];
+    }
+
+  public:
+    [[nodiscard]] persistent_vector push(const T &elt) const;
+    [[nodiscard]] persistent_vector set(int idx, const T &elt) const;
+    [[nodiscard]] persistent_vector pop() const;
+    [[nodiscard]] transient_vector transient() const;
+
+  private:
+    static int tail_offset(int len) noexcept
+    {
+        return len < _width ? 0 : ((len - 1) >> _bits) << _bits;
+    }
+
+    static void check_index(int p_idx, int len)
+    {
+        if (p_idx < 0)
+        {
+            throw dsx::structs::exceptions::NegativeIndexExecption();
+        }
+
+        if (p_idx >= len)
+        {
+            throw std::out_of_range("The index: " + std::to_string(p_idx) + " is out of bounds of vector with len " +
+                                    std::to_string(len));
+        }
+    }
+
+    static edit_t next_edit() noexcept
+    {
+        static std::atomic<edit_t> counter = {0};
+        return ++counter;
+    }
+
+    /**
+     * @brief Returns a node the caller may mutate: the node itself if the
+     * transient `edit` already owns it, a copy tagged with `edit` otherwise.
+     * Persistent updates pass edit 0 and therefore always copy.
+     */
+    template <typename Node> static std::shared_ptr<Node> editable(const std::shared_ptr<Node> &node, edit_t edit)
+    {
+        if (edit != 0 && node->edit == edit)
+        {
+            return node;
+        }
+        auto copy = std::make_shared<Node>(*node);
+        copy->edit = edit;
+        return copy;
+    }
+
+    static leaf *leaf_for(const std::shared_ptr<branch> &root, const std::shared_ptr<leaf> &tail, int shift, int len,
+                          int p_idx) noexcept;
+    static std::shared_ptr<branch> new_path(int level, const std::shared_ptr<void> &node, edit_t edit);
+    static std::shared_ptr<branch> push_tail(int level, const std::shared_ptr<branch> &parent,
+                                             const std::shared_ptr<leaf> &tail, int len, edit_t edit);
+    static std::shared_ptr<branch> do_set(int level, const std::shared_ptr<branch> &node, int p_idx, const T &elt,
+                                          edit_t edit);
+    static std::shared_ptr<branch> pop_tail(int level, const std::shared_ptr<branch> &node, int len, edit_t edit);
+
+    // The shared update algorithms; `edit` selects persistent (0) or transient
+    // behaviour through editable().
+    static void push_into(int &len, int &shift, std::shared_ptr<branch> &root, std::shared_ptr<leaf> &tail,
+                          const T &elt, edit_t edit);
+    static void set_into(int len, int shift, std::shared_ptr<branch> &root, std::shared_ptr<leaf> &tail, int p_idx,
+                         const T &elt, edit_t edit);
+    static void pop_from(int &len, int &shift, std::shared_ptr<branch> &root, std::shared_ptr<leaf> &tail,
+                         edit_t edit);
+};
+
+/**
+ * @brief A mutable, single-owner view of a persistent_vector for batch edits.
+ *
+ * Nodes copied by a transient are tagged with its id and mutated in place on
+ * subsequent edits, so a batch of n pushes allocates about n / 32 leaves
+ * instead of n. The versions it was created from are never modified.
+ *
+ * A transient must not be shared between threads, and becomes unusable once
+ * persistent() has been called on it. It is move-only: a copy would carry the
+ * same id and could write to nodes the other copy, or a frozen version, sees.
+ */
+template <typename T> class persistent_vector<T>::transient_vector
+{
+  private:
+    friend class persistent_vector<T>;
+
+    int _len;
+    int _shift;
+    std::shared_ptr<branch> _root;
+    std::shared_ptr<leaf> _tail;
+    edit_t _edit;
+
+    explicit transient_vector(const persistent_vector<T> &from)
+        : _len(from._len), _shift(from._shift), _root(from._root), _tail(from._tail),
+          _edit(persistent_vector<T>::next_edit())
+    {
+    }
+
+    void ensure_editable() const
+    {
+        if (_edit == 0)
+        {
+            throw std::logic_error("transient_vector used after persistent()");
+        }
+    }
+
+  public:
+    transient_vector(const transient_vector &) = delete;
+    transient_vector &operator=(const transient_vector &) = delete;
+
+    /**
+     * @brief Move constructor, takes over the edit id. The moved-from
+     * transient becomes unusable, as after persistent().
+     */
+    transient_vector(transient_vector &&other) noexcept
+        : _len(other._len), _shift(other._shift), _root(std::move(other._root)), _tail(std::move(other._tail)),
+          _edit(std::exchange(other._edit, 0))
+    {
+    }
+
+    /**
+     * @brief Move assignment operator, takes over the edit id. The moved-from
+     * transient becomes unusable, as after persistent().
+     */
+    transient_vector &operator=(transient_vector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            _len = other._len;
+            _shift = other._shift;
+            _root = std::move(other._root);
+            _tail = std::move(other._tail);
+            _edit = std::exchange(other._edit, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Get the current number of elements.
+     * @return The number of elements in the vector.
+     */
+    [[nodiscard]] int len() const
+    {
+        return _len;
+    }
+
+    /**
+     * @brief Returns the element at the specified index.
+     *
+     * @param p_idx The index of the element to access.
+     * @return The element at the specified index.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    T at(int p_idx) const
+    {
+        ensure_editable();
+        check_index(p_idx, _len);
+        return leaf_for(_root, _tail, _shift, _len, p_idx)->vals[p_idx & _mask];
+    }
+
+    /**
+     * @brief Adds an element to the end of the vector in place.
+     * @param elt The element to be added to the end of the vector.
+     * @return A reference to this transient, for chaining.
+     */
+    transient_vector &push(const T &elt)
+    {
+        ensure_editable();
+        push_into(_len, _shift, _root, _tail, elt, _edit);
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the element at the specified index in place.
+     * @throws std::out_of_range If the index is out of range.
+     */
+    transient_vector &set(int p_idx, const T &elt)
+    {
+        ensure_editable();
+        check_index(p_idx, _len);
+        set_into(_len, _shift, _root, _tail, p_idx, elt, _edit);
+        return *this;
+    }
+
+    /**
+     * @brief Removes the last element in place. Does nothing if empty.
+     */
+    transient_vector &pop()
+    {
+        ensure_editable();
+        pop_from(_len, _shift, _root, _tail, _edit);
+        return *this;
+    }
+
+    /**
+     * @brief Freezes the edits into a new immutable version in O(1).
+     *
+     * @return The persistent version holding the transient's contents.
+     * @throws std::logic_error If the transient was already frozen.
+     */
+    persistent_vector<T> persistent()
+    {
+        ensure_editable();
+        _edit = 0; // Nodes tagged with the old id can no longer be reached for writing
+
+        return persistent_vector<T>(_len, _shift, std::move(_root), std::move(_tail));
+    }
+};
+
+} // namespace dsx::structs
+
+/**
+ * @brief Finds the leaf holding the given index, either the tail or a leaf of
+ * the trie.
+ */
+template <typename T>
+typename dsx::structs::persistent_vector<T>::leaf *dsx::structs::persistent_vector<T>::leaf_for(
+    const std::shared_ptr<branch> &root, const std::shared_ptr<leaf> &tail, int shift, int len, int p_idx) noexcept
+{
+    if (p_idx >= tail_offset(len))
+    {
+        return tail.get();
+    }
+
+    branch *node = root.get();
+    for (int level = shift; level > _bits; level -= _bits)
+    {
+        node = static_cast<branch *>(node->kids[(p_idx >> level) & _mask].get());
+    }
+    return static_cast<leaf *>(node->kids[(p_idx >> _bits) & _mask].get());
+}
+
+/**
+ * @brief Builds a chain of single-child branches from `level` down to `node`.
+ */
+template <typename T>
+std::shared_ptr<typename dsx::structs::persistent_vector<T>::branch> dsx::structs::persistent_vector<T>::new_path(
+    int level, const std::shared_ptr<void> &node, edit_t edit)
+{
+    auto ret = std::make_shared<branch>();
+    ret->edit = edit;
+    ret->kids[0] = level == _bits ? node : new_path(level - _bits, node, edit);
+    return ret;
+}
+
+/**
+ * @brief Inserts a full tail leaf as the rightmost leaf under `parent`.
+ *
+ * `len` is the element count before the push, so the tail covers indices
+ * [len - 32, len).
+ */
+template <typename T>
+std::shared_ptr<typename dsx::structs::persistent_vector<T>::branch> dsx::structs::persistent_vector<T>::push_tail(
+    int level, const std::shared_ptr<branch> &parent, const std::shared_ptr<leaf> &tail, int len, edit_t edit)
+{
+    int subidx = ((len - 1) >> level) & _mask;
+    auto ret = editable(parent, edit);
+
+    if (level == _bits)
+    {
+        ret->kids[subidx] = tail;
+    }
+    else if (auto child = std::static_pointer_cast<branch>(parent->kids[subidx]))
+    {
+        ret->kids[subidx] = push_tail(level - _bits, child, tail, len, edit);
+    }
+    else
+    {
+        ret->kids[subidx] = new_path(level - _bits, tail, edit);
+    }
+    return ret;
+}
+
+/**
+ * @brief Replaces one element in the trie, copying the path to its leaf.
+ */
+template <typename T>
+std::shared_ptr<typename dsx::structs::persistent_vector<T>::branch> dsx::structs::persistent_vector<T>::do_set(
+    int level, const std::shared_ptr<branch> &node, int p_idx, const T &elt, edit_t edit)
+{
+    auto ret = editable(node, edit);
+    int subidx = (p_idx >> level) & _mask;
+
+    if (level == _bits)
+    {
+        auto child = editable(std::static_pointer_cast<leaf>(node->kids[subidx]), edit);
+        child->vals[p_idx & _mask] = elt;
+        ret->kids[subidx] = child;
+    }
+    else
+    {
+        ret->kids[subidx] = do_set(level - _bits, std::static_pointer_cast<branch>(node->kids[subidx]), p_idx, elt, edit);
+    }
+    return ret;
+}
+
+/**
+ * @brief Detaches the rightmost leaf of the trie.
+ *
+ * @return The new subtree, or nullptr if it became empty.
+ */
+template <typename T>
+std::shared_ptr<typename dsx::structs::persistent_vector<T>::branch> dsx::structs::persistent_vector<T>::pop_tail(
+    int level, const std::shared_ptr<branch> &node, int len, edit_t edit)
+{
+    int subidx = ((len - 2) >> level) & _mask;
+
+    if (level > _bits)
+    {
+        auto child = pop_tail(level - _bits, std::static_pointer_cast<branch>(node->kids[subidx]), len, edit);
+        if (!child && subidx == 0)
+        {
+            return nullptr;
+        }
+        auto ret = editable(node, edit);
+        ret->kids[subidx] = child;
+        return ret;
+    }
+
+    if (subidx == 0)
+    {
+        return nullptr;
+    }
+    auto ret = editable(node, edit);
+    ret->kids[subidx] = nullptr;
+    return ret;
+}
+
+template <typename T>
+void dsx::structs::persistent_vector<T>::push_into(int &len, int &shift, std::shared_ptr<branch> &root,
+                                                   std::shared_ptr<leaf> &tail, const T &elt, edit_t edit)
+{
+    if (len - tail_offset(len) < _width)
+    {
+        tail = editable(tail, edit);
+        tail->vals[len & _mask] = elt;
+        ++len;
+        return;
+    }
+
+    // The tail is full: move it into the trie, growing a level if the root is full
+    if ((len >> _bits) > (1 << shift))
+    {
+        auto new_root = std::make_shared<branch>();
+        new_root->edit = edit;
+        new_root->kids[0] = root;
+        new_root->kids[1] = new_path(shift, tail, edit);
+        root = new_root;
+        shift += _bits;
+    }
+    else
+    {
+        root = push_tail(shift, root, tail, len, edit);
+    }
+
+    tail = std::make_shared<leaf>();
+    tail->edit = edit;
+    tail->vals[0] = elt;
+    ++len;
+}
+
+template <typename T>
+void dsx::structs::persistent_vector<T>::set_into(int len, int shift, std::shared_ptr<branch> &root,
+                                                  std::shared_ptr<leaf> &tail, int p_idx, const T &elt, edit_t edit)
+{
+    if (p_idx >= tail_offset(len))
+    {
+        tail = editable(tail, edit);
+        tail->vals[p_idx & _mask] = elt;
+        return;
+    }
+    root = do_set(shift, root, p_idx, elt, edit);
+}
+
+template <typename T>
+void dsx::structs::persistent_vector<T>::pop_from(int &len, int &shift, std::shared_ptr<branch> &root,
+                                                  std::shared_ptr<leaf> &tail, edit_t edit)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    if (len - tail_offset(len) > 1)
+    {
+        tail = editable(tail, edit);
+        tail->vals[(len - 1) & _mask] = T{};
+        --len;
+        return;
+    }
+
+    if (len == 1)
+    {
+        root = std::make_shared<branch>();
+        tail = std::make_shared<leaf>();
+        shift = _bits;
+        len = 0;
+        return;
+    }
+
+    // The tail becomes empty: the rightmost leaf of the trie becomes the new tail
+    branch *node = root.get();
+    for (int level = shift; level > _bits; level -= _bits)
+    {
+        node = static_cast<branch *>(node->kids[((len - 2) >> level) & _mask].get());
+    }
+    auto new_tail = std::static_pointer_cast<leaf>(node->kids[((len - 2) >> _bits) & _mask]);
+
+    auto new_root = pop_tail(shift, root, len, edit);
+    if (!new_root)
+    {
+        new_root = std::make_shared<branch>();
+    }
+    if (shift > _bits && !new_root->kids[1])
+    {
+        new_root = std::static_pointer_cast<branch>(new_root->kids[0]);
+        shift -= _bits;
+    }
+
+    root = new_root;
+    tail = new_tail;
+    --len;
+}
+
+/**
+ * @brief Returns a new version with an element added to the end.
+ *
+ * @param elt The element to be added to the end of the vector.
+ * @return The new version; this one is unchanged.
+ */
+template <typename T>
+dsx::structs::persistent_vector<T> dsx::structs::persistent_vector<T>::push(const T &elt) const
+{
+    persistent_vector<T> next = *this;
+    push_into(next._len, next._shift, next._root, next._tail, elt, 0);
+    return next;
+}
+
+/**
+ * @brief Returns a new version with the element at the specified index
+ * replaced.
+ *
+ * @param idx The index of the element to replace.
+ * @param elt The new value.
+ * @return The new version; this one is unchanged.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename T>
+dsx::structs::persistent_vector<T> dsx::structs::persistent_vector<T>::set(int idx, const T &elt) const
+{
+    check_index(idx, _len);
+    persistent_vector<T> next = *this;
+    set_into(next._len, next._shift, next._root, next._tail, idx, elt, 0);
+    return next;
+}
+
+/**
+ * @brief Returns a new version without the last element.
+ *
+ * Popping an empty vector returns another empty vector.
+ *
+ * @return The new version; this one is unchanged.
+ */
+template <typename T> dsx::structs::persistent_vector<T> dsx::structs::persistent_vector<T>::pop() const
+{
+    persistent_vector<T> next = *this;
+    pop_from(next._len, next._shift, next._root, next._tail, 0);
+    return next;
+}
+
+/**
+ * @brief Starts a batch edit on top of this version.
+ *
+ * @return A transient holding the same elements.
+ */
+template <typename T>
+typename dsx::structs::persistent_vector<T>::transient_vector dsx::structs::persistent_vector<T>::transient() const
+{
+    return transient_vector(*this);
+}
+
+#endif // LIBDSX_PERSISTENT_VECTOR_H
@@ -1,12 +1,22 @@
+#include "bit_vector.hpp"
+#include "concurrent_vector.hpp"
+#include "incremental_vector.hpp"
+#include "persistent_vector.hpp"
 #include "vector.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 template <typename T>
 double benchmarkCustomVectorPushBack(long long iterations) {
-  dsx::structs::vector<T> custom_vector(iterations);
+  dsx::structs::vector<T> custom_vector;
+  custom_vector.reserve(iterations + 1);
 
   auto start = std::chrono::high_resolution_clock::now();
   for (int i = 0; i < iterations; ++i) {
@@ -18,9 +28,17 @@ double benchmarkCustomVectorPushBack(long long iterations) {
   return duration.count() * 1000.0;
 }
 
+template <typename T> T make_push_value(long long i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return "a string too long for SSO #" + std::to_string(i);
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
 template <typename T> double benchmarkStdVectorPushBack(long long iterations) {
   std::vector<T> std_vector;
-  std_vector.reserve(iterations);
+  std_vector.reserve(iterations + 1);
   auto start = std::chrono::high_resolution_clock::now();
   for (int i = 0; i < iterations; ++i) {
     std_vector.push_back(i);
@@ -31,6 +49,184 @@ template <typename T> double benchmarkStdVectorPushBack(long long iterations) {
   return duration.count() * 1000.0;
 }
 
+// Worst single push() latency in nanoseconds, starting from an empty
+// container so that every growth step is part of the measurement. The run is
+// repeated `trials` times and the smallest worst case is kept, since a single
+// run's maximum is mostly scheduler and page-fault noise on a busy machine.
+// A pre-reserved container (no growth at all) gives the noise floor.
+
+template <typename Vec, typename T = int>
+double benchmarkWorstPushLatency(long long iterations, int trials = 5,
+                                 bool reserved = false) {
+  double best = std::numeric_limits<double>::max();
+
+  for (int trial = 0; trial < trials; ++trial) {
+    Vec vec;
+    if (reserved) {
+      vec.reserve(iterations);
+    }
+    double worst = 0.0;
+
+    for (long long i = 0; i < iterations; ++i) {
+      T value = make_push_value<T>(i);
+      auto start = std::chrono::high_resolution_clock::now();
+      vec.push(value);
+      auto end = std::chrono::high_resolution_clock::now();
+
+      std::chrono::duration<double, std::nano> duration = end - start;
+      worst = std::max(worst, duration.count());
+    }
+    best = std::min(best, worst);
+  }
+  return best;
+}
+
+// Wall time in milliseconds for `threads` threads to push `total` elements
+// into one concurrent_vector between them.
+inline double benchmarkConcurrentPush(int threads, long long total) {
+  dsx::structs::concurrent_vector<int> custom_vector;
+  std::vector<std::thread> workers;
+  long long per_thread = total / threads;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&custom_vector, per_thread] {
+      for (long long i = 0; i < per_thread; ++i) {
+        custom_vector.push(static_cast<int>(i));
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  std::chrono::duration<double> duration = end - start;
+  return duration.count() * 1000.0;
+}
+
+// Time in milliseconds to take `snapshots` snapshots of a `size` element
+// vector, updating one element after each snapshot.
+inline double benchmarkPersistentSnapshots(int size, int snapshots) {
+  auto batch = dsx::structs::persistent_vector<int>().transient();
+  for (int i = 0; i < size; ++i) {
+    batch.push(i);
+  }
+  auto current = batch.persistent();
+  std::vector<dsx::structs::persistent_vector<int>> kept;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < snapshots; ++i) {
+    kept.push_back(current);
+    current = current.set(i % size, -i);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  std::chrono::duration<double> duration = end - start;
+  return duration.count() * 1000.0;
+}
+
+inline double benchmarkStdVectorSnapshots(int size, int snapshots) {
+  std::vector<int> current(size);
+  std::vector<std::vector<int>> kept;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < snapshots; ++i) {
+    kept.push_back(current);
+    current[i % size] = -i;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  std::chrono::duration<double> duration = end - start;
+  return duration.count() * 1000.0;
+}
+
+inline double benchmarkBitVectorCount(int size, int rounds) {
+  dsx::structs::bit_vector bits(size);
+  for (int i = 0; i < size; i += 3) {
+    bits.set(i);
+  }
+
+  long long total = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    total += bits.count();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (total != static_cast<long long>(rounds) * ((size + 2) / 3)) {
+    std::cerr << "bit_vector count mismatch\n";
+  }
+  std::chrono::duration<double, std::milli> duration = end - start;
+  return duration.count();
+}
+
+inline double benchmarkBoolVectorCount(int size, int rounds) {
+  dsx::structs::vector<bool> flags(size);
+  for (int i = 0; i < size; ++i) {
+    flags.push(i % 3 == 0);
+  }
+
+  long long total = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    const bool *data = flags.data();
+    for (int i = 0; i < size; ++i) {
+      total += data[i];
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (total != static_cast<long long>(rounds) * ((size + 2) / 3)) {
+    std::cerr << "vector<bool> count mismatch\n";
+  }
+  std::chrono::duration<double, std::milli> duration = end - start;
+  return duration.count();
+}
+
+inline double benchmarkBitVectorFindSparse(int size, int stride) {
+  dsx::structs::bit_vector bits(size);
+  for (int i = 0; i < size; i += stride) {
+    bits.set(i);
+  }
+
+  int found = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int p = bits.find_first(); p != -1; p = bits.find_next(p)) {
+    ++found;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (found != (size + stride - 1) / stride) {
+    std::cerr << "bit_vector find mismatch\n";
+  }
+  std::chrono::duration<double, std::milli> duration = end - start;
+  return duration.count();
+}
+
+inline double benchmarkBoolVectorFindSparse(int size, int stride) {
+  dsx::structs::vector<bool> flags(size);
+  for (int i = 0; i < size; ++i) {
+    flags.push(i % stride == 0);
+  }
+
+  int found = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  const bool *data = flags.data();
+  for (int i = 0; i < size; ++i) {
+    if (data[i]) {
+      ++found;
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (found != (size + stride - 1) / stride) {
+    std::cerr << "vector<bool> find mismatch\n";
+  }
+  std::chrono::duration<double, std::milli> duration = end - start;
+  return duration.count();
+}
+
 inline int vec_bench() {
   std::vector<long long> iters;
   for (int i = 0; i <= 6; i++) {
@@ -61,5 +257,75 @@ inline int vec_bench() {
     std::cout << "---------------------------------\n";
   }
 
+  std::cout << "\nWorst-case push() latency (growing from empty, best of 5 "
+               "runs):\n";
+  std::cout << "------------------------\n";
+
+  for (long long iteration : {1000LL, 100000LL, 1000000LL, 4000000LL}) {
+    std::cout << "Iterations: " << iteration << std::endl;
+    std::cout << "Reserved vector (int, noise floor) worst push: "
+              << benchmarkWorstPushLatency<dsx::structs::vector<int>>(
+                     iteration, 5, true)
+              << " ns\n";
+    std::cout << "Custom vector (int) worst push: "
+              << benchmarkWorstPushLatency<dsx::structs::vector<int>>(iteration)
+              << " ns\n";
+    std::cout << "Incremental vector (int) worst push: "
+              << benchmarkWorstPushLatency<
+                     dsx::structs::incremental_vector<int>>(iteration)
+              << " ns\n";
+    std::cout << "Custom vector (string) worst push: "
+              << benchmarkWorstPushLatency<dsx::structs::vector<std::string>,
+                                           std::string>(iteration)
+              << " ns\n";
+    std::cout << "Incremental vector (string) worst push: "
+              << benchmarkWorstPushLatency<
+                     dsx::structs::incremental_vector<std::string>,
+                     std::string>(iteration)
+              << " ns\n";
+    std::cout << "---------------------------------\n";
+  }
+
+  std::cout << "\nConcurrent push() scaling (10000000 elements total):\n";
+  std::cout << "------------------------\n";
+
+  double single_thread_time = 0.0;
+  for (int threads = 1; threads <= 8; threads *= 2) {
+    double time = benchmarkConcurrentPush(threads, 10000000);
+    if (threads == 1) {
+      single_thread_time = time;
+    }
+    std::cout << "Threads: " << threads << " time: " << time
+              << " ms, speedup: " << single_thread_time / time << "x\n";
+  }
+
+  std::cout << "\nSnapshot + update (100 snapshots):\n";
+  std::cout << "------------------------\n";
+
+  for (int size : {1000, 100000, 1000000}) {
+    std::cout << "Elements: " << size << std::endl;
+    std::cout << "Persistent vector (int) time: "
+              << benchmarkPersistentSnapshots(size, 100) << " ms\n";
+    std::cout << "Std vector copy (int) time: "
+              << benchmarkStdVectorSnapshots(size, 100) << " ms\n";
+    std::cout << "---------------------------------\n";
+  }
+
+  std::cout << "\nPacked bits vs vector<bool> (count x100, sparse find 1/1000):\n";
+  std::cout << "------------------------\n";
+
+  for (int size : {100000, 1000000, 10000000}) {
+    std::cout << "Bits: " << size << std::endl;
+    std::cout << "bit_vector count time: " << benchmarkBitVectorCount(size, 100)
+              << " ms\n";
+    std::cout << "vector<bool> count time: "
+              << benchmarkBoolVectorCount(size, 100) << " ms\n";
+    std::cout << "bit_vector find_next walk time: "
+              << benchmarkBitVectorFindSparse(size, 1000) << " ms\n";
+    std::cout << "vector<bool> scan time: "
+              << benchmarkBoolVectorFindSparse(size, 1000) << " ms\n";
+    std::cout << "---------------------------------\n";
+  }
+
   return 0;
 }
@@ -1,9 +1,20 @@
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "bit_vector.hpp"
+#include "concurrent_vector.hpp"
+#include "incremental_vector.hpp"
+#include "persistent_vector.hpp"
+#include "queue/queue.hpp"
 #include "vector.hpp"
 
 // Helper macro for test assertions
+#ifndef ASSERT
 #define ASSERT(condition)                                                                                              \
     do                                                                                                                 \
     {                                                                                                                  \
@@ -14,6 +25,7 @@
             exit(-1);                                                                                                  \
         }                                                                                                              \
     } while (0)
+#endif
 
 inline int vec_test()
 {
@@ -86,6 +98,12 @@ inline int vec_test()
     ASSERT(v7.len() == 2);
     ASSERT(v7[0] == 1);
     ASSERT(v7[1] == 2);
+    v7.resize(4); // Grows the length within the capacity, the dropped 3 does not come back
+    ASSERT(v7.len() == 4 && v7.capacity() == 5);
+    ASSERT(v7[1] == 2 && v7[2] == 0 && v7[3] == 0);
+    v7.resize(12); // Grows past the capacity
+    ASSERT(v7.len() == 12 && v7.capacity() >= 12);
+    ASSERT(v7[0] == 1 && v7[3] == 0 && v7[11] == 0);
     std::cout << "Test 8 (Resize) passed!" << std::endl;
 
     // Test 9: Swap
@@ -100,3 +118,527 @@ inline int vec_test()
 
     return 0;
 }
+
+// Counts live objects so tests can check what a container constructs and destroys
+struct live_counted
+{
+    static inline int live = 0;
+    int value = 0;
+
+    live_counted() noexcept
+    {
+        ++live;
+    }
+
+    explicit live_counted(int v) noexcept : value(v)
+    {
+        ++live;
+    }
+
+    live_counted(const live_counted &other) noexcept : value(other.value)
+    {
+        ++live;
+    }
+
+    live_counted &operator=(const live_counted &) = default;
+
+    ~live_counted()
+    {
+        --live;
+    }
+};
+
+inline int incremental_vec_test()
+{
+    // Test 1: Growth keeps every element reachable while migrating
+    dsx::structs::incremental_vector<int, 1> v1;
+    for (int i = 0; i < 6; i++)
+    {
+        v1.push(i);
+    }
+    ASSERT(v1.len() == 6);
+    ASSERT(v1.capacity() == 10);
+    ASSERT(v1.is_migrating());
+    ASSERT(v1.at(4) == 4 && v1.at(5) == 5);
+    std::cout << "Test 1 (Incremental Growth) passed!" << std::endl;
+
+    // Test 2: Migration finishes before the new array fills up
+    for (int i = 6; i < 10; i++)
+    {
+        v1.push(i);
+    }
+    ASSERT(!v1.is_migrating());
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT(v1[i] == i);
+    }
+    std::cout << "Test 2 (Migration Completes) passed!" << std::endl;
+
+    // Test 3: Pop while elements still live in the old array
+    dsx::structs::incremental_vector<int, 1> v2;
+    for (int i = 0; i < 6; i++)
+    {
+        v2.push(i);
+    }
+    for (int i = 5; i >= 0; i--)
+    {
+        auto popped = v2.pop();
+        ASSERT(popped.has_value() && popped.value() == i);
+    }
+    ASSERT(v2.is_empty() && !v2.is_migrating());
+    ASSERT(!v2.pop().has_value());
+    std::cout << "Test 3 (Pop During Migration) passed!" << std::endl;
+
+    // Test 4: Reserve and clear
+    dsx::structs::incremental_vector<int> v3;
+    for (int i = 0; i < 100; i++)
+    {
+        v3.push(i);
+    }
+    v3.reserve(1000);
+    ASSERT(v3.capacity() == 1000 && !v3.is_migrating());
+    ASSERT(v3.front() == 0 && v3.back() == 99);
+    v3.clear();
+    ASSERT(v3.len() == 0 && v3.capacity() == 1000);
+    std::cout << "Test 4 (Reserve and Clear) passed!" << std::endl;
+
+    // Test 5: Growing constructs nothing, each step destroys what it migrated
+    {
+        dsx::structs::incremental_vector<live_counted, 2> v4;
+        for (int i = 0; i < 5; i++)
+        {
+            v4.push(live_counted(i));
+        }
+        ASSERT(live_counted::live == 5);
+        v4.push(live_counted(5)); // Grows to 10 slots, migrates 2
+        ASSERT(v4.is_migrating() && live_counted::live == 6);
+        auto popped = v4.pop();
+        ASSERT(popped.has_value() && popped->value == 5 && live_counted::live == 6);
+        popped.reset();
+        ASSERT(live_counted::live == 5 && v4.at(4).value == 4);
+        v4.clear();
+        ASSERT(live_counted::live == 0 && !v4.is_migrating());
+        v4.push(live_counted(7));
+    }
+    ASSERT(live_counted::live == 0);
+    std::cout << "Test 5 (Raw Storage) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
+
+inline int concurrent_vec_test()
+{
+    // Test 1: Indices are handed out in order and never move
+    dsx::structs::concurrent_vector<int, 4> v1;
+    ASSERT(v1.is_empty() && v1.capacity() == 0);
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT(v1.push(i * 10) == i);
+    }
+    int *first = &v1[0];
+    for (int i = 4; i < 100; i++)
+    {
+        v1.push(i * 10);
+    }
+    ASSERT(&v1[0] == first);
+    ASSERT(v1.len() == 100 && v1.at(99) == 990);
+    ASSERT(v1.capacity() == 4 + 8 + 16 + 32 + 64);
+    std::cout << "Test 1 (Stable Indices) passed!" << std::endl;
+
+    // Test 2: Pushes from several threads land exactly once each
+    dsx::structs::concurrent_vector<int, 4> v2;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++)
+    {
+        workers.emplace_back([&v2, t] {
+            for (int i = 0; i < 10000; i++)
+            {
+                v2.push(t * 10000 + i);
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    ASSERT(v2.len() == 40000);
+    std::vector<bool> seen(40000, false);
+    for (int i = 0; i < v2.len(); i++)
+    {
+        ASSERT(!seen[v2[i]]);
+        seen[v2[i]] = true;
+    }
+    std::cout << "Test 2 (Concurrent Push) passed!" << std::endl;
+
+    // Test 3: Reserve allocates whole segments up front
+    dsx::structs::concurrent_vector<int, 4> v3(13);
+    ASSERT(v3.capacity() == 4 + 8 + 16 && v3.len() == 0);
+    std::cout << "Test 3 (Reserve) passed!" << std::endl;
+
+    // Test 4: Readers may scan [0, len()) while pushes are in flight
+    dsx::structs::concurrent_vector<int, 4> v4;
+    std::atomic<bool> writing = {true};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; t++)
+    {
+        writers.emplace_back([&v4] {
+            for (int i = 1; i <= 20000; i++)
+            {
+                v4.push(i);
+            }
+        });
+    }
+    bool consistent = true;
+    std::thread reader([&] {
+        while (writing.load())
+        {
+            int n = v4.len();
+            for (int i = 0; i < n; i++)
+            {
+                int value = v4.at(i);
+                consistent = consistent && value >= 1 && value <= 20000;
+            }
+        }
+    });
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+    writing.store(false);
+    reader.join();
+    ASSERT(consistent && v4.len() == 40000);
+    std::cout << "Test 4 (Concurrent Read) passed!" << std::endl;
+
+    // Test 5: Segments are raw storage, only pushed elements are constructed
+    struct counted
+    {
+        int *live;
+        std::string text;
+        counted(int *p_live, std::string p_text) : live(p_live), text(std::move(p_text))
+        {
+            ++*live;
+        }
+        counted(const counted &other) : live(other.live), text(other.text)
+        {
+            ++*live;
+        }
+        ~counted()
+        {
+            --*live;
+        }
+    };
+    int live = 0;
+    {
+        dsx::structs::concurrent_vector<counted, 4> v5(1000);
+        for (int i = 0; i < 50; i++)
+        {
+            v5.push(counted(&live, "a string too long for SSO #" + std::to_string(i)));
+        }
+        ASSERT(live == 50 && v5.len() == 50 && v5[49].text.ends_with("#49"));
+    }
+    ASSERT(live == 0);
+    std::cout << "Test 5 (Raw Segments) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
+
+inline int persistent_vec_test()
+{
+    // Test 1: Push returns a new version and leaves the old one intact
+    dsx::structs::persistent_vector<int> v1;
+    auto v2 = v1.push(1).push(2).push(3);
+    ASSERT(v1.is_empty());
+    ASSERT(v2.len() == 3 && v2[0] == 1 && v2[2] == 3 && v2.back() == 3);
+    std::cout << "Test 1 (Persistent Push) passed!" << std::endl;
+
+    // Test 2: Growing through several trie levels
+    dsx::structs::persistent_vector<int> v3;
+    for (int i = 0; i < 40000; i++)
+    {
+        v3 = v3.push(i);
+    }
+    ASSERT(v3.len() == 40000);
+    for (int i = 0; i < 40000; i++)
+    {
+        ASSERT(v3[i] == i);
+    }
+    std::cout << "Test 2 (Trie Growth) passed!" << std::endl;
+
+    // Test 3: Set and pop on a snapshot do not leak into the original
+    auto snapshot = v3;
+    auto v4 = v3.set(5, -5).set(39999, -1);
+    ASSERT(v4[5] == -5 && v4[39999] == -1);
+    ASSERT(snapshot[5] == 5 && snapshot[39999] == 39999);
+    auto v5 = v3;
+    for (int i = 39999; i >= 0; i--)
+    {
+        ASSERT(v5.back() == i);
+        v5 = v5.pop();
+    }
+    ASSERT(v5.is_empty() && v3.len() == 40000 && v3[1024] == 1024);
+    std::cout << "Test 3 (Snapshot Isolation) passed!" << std::endl;
+
+    // Test 4: Transient batch edits
+    auto batch = snapshot.transient();
+    for (int i = 0; i < 2000; i++)
+    {
+        batch.push(40000 + i);
+    }
+    batch.set(0, 100).pop();
+    auto v6 = batch.persistent();
+    ASSERT(v6.len() == 41999 && v6[0] == 100 && v6[41998] == 41998);
+    ASSERT(snapshot.len() == 40000 && snapshot[0] == 0);
+    bool threw = false;
+    try
+    {
+        batch.push(1);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    ASSERT(threw);
+    dsx::structs::persistent_vector<int> v7 = {1, 2, 3};
+    ASSERT(v7.len() == 3 && v7.at(1) == 2);
+    std::cout << "Test 4 (Transient) passed!" << std::endl;
+
+    // Test 5: Transients are move-only, and a moved-from one is unusable
+    using transient_t = dsx::structs::persistent_vector<int>::transient_vector;
+    static_assert(!std::is_copy_constructible_v<transient_t> && !std::is_copy_assignable_v<transient_t>);
+    static_assert(std::is_nothrow_move_constructible_v<transient_t>);
+    auto first = v7.transient();
+    first.push(4);
+    auto second = std::move(first);
+    second.set(0, 10);
+    threw = false;
+    try
+    {
+        first.set(0, 20);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    auto v8 = second.persistent();
+    ASSERT(threw && v8.len() == 4 && v8[0] == 10 && v8[3] == 4 && v7[0] == 1);
+    std::cout << "Test 5 (Move-only Transient) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
+
+inline int vec_stats_test()
+{
+    // Test 1: The default policy costs no space and reports nothing
+    struct same_layout
+    {
+        int cap;
+        int *arr;
+        int len;
+    };
+    static_assert(sizeof(dsx::structs::vector<int>) == sizeof(same_layout));
+    dsx::structs::vector<int> v1 = {1, 2, 3};
+    ASSERT(!v1.stats().enabled && v1.stats().allocations == 0);
+    std::cout << "Test 1 (Stats Disabled) passed!" << std::endl;
+
+    // Test 2: Growth, copies and peaks are counted
+    dsx::structs::vector<int, dsx::stats::counting> v2;
+    for (int i = 0; i < 10; i++)
+    {
+        v2.push(i);
+    }
+    auto snap = v2.stats();
+    ASSERT(snap.enabled);
+    ASSERT(snap.allocations == 3 && snap.deallocations == 2);
+    ASSERT(snap.growth_events == 2 && snap.elements_copied == 4 + 9);
+    ASSERT(snap.peak_len == 10 && snap.peak_capacity == 20);
+    ASSERT(snap.slack == 10 && snap.slack_bytes == 10 * sizeof(int));
+    std::cout << "Test 2 (Growth Stats) passed!" << std::endl;
+
+    // Test 3: Shifts count as copies, peaks survive shrinking
+    v2.erase_at(0);
+    v2.shrink();
+    snap = v2.stats();
+    ASSERT(snap.elements_copied == 4 + 9 + 9 + 9);
+    ASSERT(snap.peak_capacity == 20 && snap.capacity == 9 && snap.slack == 0);
+    std::cout << "Test 3 (Shift Stats) passed!" << std::endl;
+
+    // Test 4: An explicit reserve is not a growth event, swap moves the counters
+    dsx::structs::vector<int, dsx::stats::counting> v3;
+    v3.reserve(100);
+    v3.resize(50);
+    ASSERT(v3.stats().growth_events == 0 && v3.stats().peak_capacity == 100);
+    auto before = v2.stats();
+    v3.swap(v2);
+    ASSERT(v3.stats().growth_events == before.growth_events && v3.stats().elements_copied == before.elements_copied);
+    ASSERT(v2.stats().growth_events == 0 && v2.stats().peak_len == 50);
+    std::cout << "Test 4 (Reserve and Swap Stats) passed!" << std::endl;
+
+    // Test 5: Queue counts one allocation per node and reports the link overhead
+    static_assert(sizeof(Queue<int>) == 2 * sizeof(void *) + sizeof(size_t));
+    Queue<int> plain = {1, 2};
+    ASSERT(!plain.stats().enabled);
+    Queue<int, dsx::stats::counting> q = {1, 2, 3};
+    q.enqueue(4);
+    ASSERT(q.dequeue() == 4);
+    snap = q.stats();
+    ASSERT(snap.enabled && snap.allocations == 4 && snap.deallocations == 1 && snap.growth_events == 0);
+    ASSERT(snap.elements_copied == 0 && snap.peak_len == 4 && snap.len == 3 && snap.slack == 0); // Nodes never relocate
+    ASSERT(snap.slack_bytes >= 3 * 2 * sizeof(void *));
+    std::cout << "Test 5 (Queue Stats) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
+
+inline int bit_vector_test()
+{
+    // Test 1: Push, pop and single-bit access across a word boundary
+    dsx::structs::bit_vector b1;
+    for (int i = 0; i < 70; i++)
+    {
+        b1.push(i % 3 == 0);
+    }
+    ASSERT(b1.len() == 70 && b1.capacity() >= 70);
+    ASSERT(b1.at(63) && !b1.at(64) && b1.at(69));
+    auto popped = b1.pop();
+    ASSERT(popped.has_value() && popped.value() && b1.len() == 69);
+    b1.flip(1);
+    b1.reset(0);
+    ASSERT(b1.at(1) && !b1.at(0));
+    bool threw = false;
+    try
+    {
+        (void)b1.at(69);
+    }
+    catch (const std::out_of_range &)
+    {
+        threw = true;
+    }
+    ASSERT(threw);
+    std::cout << "Test 1 (Push/Pop) passed!" << std::endl;
+
+    // Test 2: Bulk range operations only touch the requested bits
+    dsx::structs::bit_vector b2(200);
+    b2.set_range(10, 150);
+    ASSERT(b2.count() == 140 && !b2.at(9) && b2.at(10) && b2.at(149) && !b2.at(150));
+    b2.flip_range(60, 70);
+    ASSERT(b2.count() == 130 && !b2.at(60) && b2.at(70));
+    b2.flip_all();
+    ASSERT(b2.count() == 70);
+    b2.set_all();
+    ASSERT(b2.count() == 200);
+    b2.reset_all();
+    ASSERT(b2.count() == 0 && b2.find_first() == -1);
+    std::cout << "Test 2 (Bulk Ops) passed!" << std::endl;
+
+    // Test 3: Resizing keeps the unused tail bits clear
+    dsx::structs::bit_vector b3(5, true);
+    b3.resize(3);
+    b3.resize(100, false);
+    ASSERT(b3.count() == 3);
+    b3.resize(130, true);
+    ASSERT(b3.count() == 33 && b3.at(129) && !b3.at(99));
+    std::cout << "Test 3 (Resize) passed!" << std::endl;
+
+    // Test 4: find_first/find_next walk the set bits in order
+    dsx::structs::bit_vector b4(300);
+    int positions[] = {0, 63, 64, 200, 299};
+    for (int p : positions)
+    {
+        b4.set(p);
+    }
+    int seen = 0;
+    for (int p = b4.find_first(); p != -1; p = b4.find_next(p))
+    {
+        ASSERT(p == positions[seen++]);
+    }
+    ASSERT(seen == 5);
+    threw = false;
+    try
+    {
+        (void)b4.find_next(-2);
+    }
+    catch (const dsx::structs::exceptions::NegativeIndexExecption &)
+    {
+        threw = true;
+    }
+    ASSERT(threw);
+    std::cout << "Test 4 (Find) passed!" << std::endl;
+
+    // Test 5: Bitwise operators work word by word and check lengths
+    dsx::structs::bit_vector lhs(100), rhs(100);
+    lhs.set_range(0, 60);
+    rhs.set_range(40, 100);
+    lhs &= rhs;
+    ASSERT(lhs.count() == 20 && lhs.find_first() == 40);
+    lhs |= rhs;
+    ASSERT(lhs.count() == 60);
+    lhs ^= rhs;
+    ASSERT(lhs.count() == 0);
+    dsx::structs::bit_vector shorter(99);
+    threw = false;
+    try
+    {
+        lhs |= shorter;
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ASSERT(threw);
+    std::cout << "Test 5 (Bitwise Ops) passed!" << std::endl;
+
+    // Test 6: rank/select agree with a linear scan and go stale on writes
+    dsx::structs::bit_vector b6;
+    std::vector<int> ones;
+    for (int i = 0; i < 2000; i++)
+    {
+        bool bit = (i * 7919) % 13 < 4;
+        b6.push(bit);
+        if (bit)
+        {
+            ones.push_back(i);
+        }
+    }
+    b6.build_rank_index();
+    int expected_rank = 0;
+    for (int i = 0; i <= b6.len(); i++)
+    {
+        ASSERT(b6.rank(i) == expected_rank);
+        if (i < b6.len() && b6.at(i))
+        {
+            expected_rank++;
+        }
+    }
+    for (int k = 0; k < static_cast<int>(ones.size()); k++)
+    {
+        ASSERT(b6.select(k) == ones[k]);
+    }
+    ASSERT(b6.select(static_cast<int>(ones.size())) == -1);
+    b6.push(true);
+    threw = false;
+    try
+    {
+        (void)b6.rank(0);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    ASSERT(threw);
+    dsx::structs::bit_vector b7(512, true);
+    b7.build_rank_index();
+    ASSERT(b7.rank(512) == 512 && b7.select(511) == 511 && b7.select(512) == -1);
+    std::cout << "Test 6 (Rank/Select) passed!" << std::endl;
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 
+#include "stats/container_stats.hpp"
 #include "v_exceptions.hpp"
 #include <algorithm>
 #include <initializer_list>
@@ -16,17 +17,37 @@
  * to accommodate the elements as they are added or removed.
  *
  * @tparam T The type of elements held in the vector.
- * @tparam cap The initial capacity of the vector. Defaults to 5.
+ * @tparam Stats The statistics policy, dsx::stats::none (default, no cost) or
+ * dsx::stats::counting.
  */
 namespace dsx::structs
 {
-template <typename T> class vector
+template <typename T, typename Stats = dsx::stats::none> class vector
 {
   private:
+    [[no_unique_address]] Stats _stats;
     int _cap = 5;
-    T *_arr = new T[_cap];
+    T *_arr = allocate(_cap);
     int _len = {0};
 
+    /**
+     * @brief Allocates an array of n elements and records it in the stats.
+     */
+    T *allocate(int n)
+    {
+        _stats.on_alloc(n, sizeof(T));
+        return new T[n];
+    }
+
+    /**
+     * @brief Releases an array and records it in the stats.
+     */
+    void release(T *arr) noexcept
+    {
+        _stats.on_free();
+        delete[] arr;
+    }
+
   public:
     /**
      * @brief Default constructor for the vector class.
@@ -49,9 +70,16 @@ template <typename T> class vector
      */
     vector(std::initializer_list<T> list) : _len(list.size())
     {
-        _arr = new T[_cap]; // Allocate memory for the array
+        if (_len > _cap)
+        {
+            release(_arr);
+            _cap = _len;
+            _arr = allocate(_cap); // Allocate memory for the array
+        }
         std::copy(list.begin(), list.end(),
                   _arr); // Copy elements from the initializer list to the array
+        _stats.on_copy(_len, sizeof(T));
+        _stats.on_size(_len, _cap);
     }
 
     /**
@@ -66,10 +94,10 @@ template <typename T> class vector
      */
     explicit vector(int p_size)
     {
-        T *n_arr = new T[p_size]; // Allocate memory for the new array with the
-                                  // given size
+        T *n_arr = allocate(p_size); // Allocate memory for the new array with the
+                                     // given size
 
-        delete[] _arr; // Deallocate memory from the previous array
+        release(_arr); // Deallocate memory from the previous array
 
         _arr = n_arr; // Update the pointer to the newly allocated array
 
@@ -81,6 +109,7 @@ template <typename T> class vector
         }
 
         _cap = p_size; // Update the capacity of the vector
+        _stats.on_size(_len, _cap);
     }
 
     /**
@@ -92,7 +121,7 @@ template <typename T> class vector
      */
     ~vector()
     {
-        delete[] _arr;
+        release(_arr);
     }
 
   public:
@@ -135,6 +164,19 @@ template <typename T> class vector
         return len() == 0;
     }
 
+    /**
+     * @brief Returns the allocation and operation statistics so far.
+     *
+     * With the default dsx::stats::none policy the snapshot is empty and has
+     * `enabled` set to false.
+     *
+     * @return A snapshot of the counters and the current length and capacity.
+     */
+    [[nodiscard]] dsx::stats::snapshot stats() const
+    {
+        return _stats.take(_len, _cap, sizeof(T), 0);
+    }
+
     void reserve(int n_size);
     void shrink();
 
@@ -223,6 +265,20 @@ template <typename T> class vector
         return _arr[_len - 1]; // Access the last element in the vector
     }
 
+    /**
+     * @brief Returns a pointer to the underlying array.
+     *
+     * The pointer is invalidated by any operation that reallocates, such as
+     * push, reserve or shrink. It allows unchecked access for containers that
+     * build on top of vector and do their own bounds bookkeeping.
+     *
+     * @return A pointer to the first element of the underlying array.
+     */
+    T *data() const noexcept
+    {
+        return _arr;
+    }
+
   public:
     void push(const T &elt);
     std::optional<T> pop();
@@ -230,7 +286,7 @@ template <typename T> class vector
     std::optional<T> erase_at(int idx);
     void clear();
     void resize(int n_size);
-    void swap(vector<T> &o_vec);
+    void swap(vector<T, Stats> &o_vec);
 };
 
 } // namespace dsx::structs
@@ -246,7 +302,7 @@ template <typename T> class vector
  * @param n_size The number of elements to reserve memory for.
  * @throws std::runtime_error If memory allocation fails.
  */
-template <typename T> void dsx::structs::vector<T>::reserve(int n_size) noexcept(false)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::reserve(int n_size) noexcept(false)
 {
     if (n_size <= _cap)
     {
@@ -254,10 +310,9 @@ template <typename T> void dsx::structs::vector<T>::reserve(int n_size) noexcept
                 // current capacity
     }
 
-    T *new_arr = new T[n_size]; // Allocate memory for the new array with the given size
+    T *new_arr = allocate(n_size); // Allocate memory for the new array with the given size
     if (!new_arr)
     {
-        delete[] new_arr; // Deallocate the memory if allocation fails
         std::stringstream ss;
         ss << "Memory reallocation failed at line: " << __LINE__ << " in function: " << __FUNCTION__;
         throw std::runtime_error(ss.str()); // Throw an error if memory allocation fails
@@ -265,9 +320,12 @@ template <typename T> void dsx::structs::vector<T>::reserve(int n_size) noexcept
 
     std::copy(_arr, _arr + _len,
               new_arr); // Copy existing elements to the new array
-    delete[] _arr;      // Deallocate the memory used by the previous array
+    release(_arr);      // Deallocate the memory used by the previous array
     _arr = new_arr;     // Update the pointer to the newly allocated array
     _cap = n_size;      // Update the capacity of the vector
+
+    _stats.on_copy(_len, sizeof(T));
+    _stats.on_size(_len, _cap);
 }
 
 /**
@@ -279,24 +337,24 @@ template <typename T> void dsx::structs::vector<T>::reserve(int n_size) noexcept
  *
  * @throws std::runtime_error If memory reallocation fails while shrinking.
  */
-template <typename T> void dsx::structs::vector<T>::shrink() noexcept(false)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::shrink() noexcept(false)
 {
     if (_len == 0)
     {
         return; // Do nothing if the vector is empty
     }
 
-    T *new_arr = new T[_len];
+    T *new_arr = allocate(_len);
     if (!new_arr)
     {
-        delete[] new_arr; // Deallocate the memory if allocation fails
         std::stringstream ss;
         ss << "Memory reallocation failed at line: " << __LINE__ << " in function: " << __FUNCTION__;
         throw std::runtime_error(ss.str()); // Throw an error if memory allocation fails
     }                                       // Allocate memory for the new array with the size of the vector's length
     std::copy(_arr, _arr + _len, new_arr);  // Copy elements to the new array
+    _stats.on_copy(_len, sizeof(T));
 
-    delete[] _arr;  // Deallocate the memory used by the previous array
+    release(_arr);  // Deallocate the memory used by the previous array
     _arr = new_arr; // Update the pointer to the newly allocated array
     if (!_arr)
     {
@@ -319,17 +377,18 @@ template <typename T> void dsx::structs::vector<T>::shrink() noexcept(false)
  *
  * @param elt The element to be added to the end of the vector.
  */
-template <typename T> void dsx::structs::vector<T>::push(const T &elt)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::push(const T &elt)
 {
     if (_len + 1 >= _cap)
     {
-        reserve(_cap * 2 * sizeof(*_arr)); // Double the capacity if the size is
-                                           // about to exceed the current capacity
-        _cap *= 2;
+        _stats.on_growth(); // Only growth forced by running out of room counts, not an explicit reserve
+        reserve(_cap == 0 ? 5 : _cap * 2); // Double the capacity if the size is about
+                                           // to exceed the current capacity
     }
 
     _arr[_len] = elt; // Add the new element to the end of the vector
     _len++;           // Increment the length of the vector
+    _stats.on_size(_len, _cap);
 }
 
 /**
@@ -342,7 +401,7 @@ template <typename T> void dsx::structs::vector<T>::push(const T &elt)
  * @return An optional containing the last element of the vector if the vector
  * is not empty, or an empty optional if the vector is empty.
  */
-template <typename T> std::optional<T> dsx::structs::vector<T>::pop()
+template <typename T, typename Stats> std::optional<T> dsx::structs::vector<T, Stats>::pop()
 {
     if (is_empty())
     {
@@ -369,7 +428,7 @@ template <typename T> std::optional<T> dsx::structs::vector<T>::pop()
  * @param elt The element to be inserted into the vector.
  * @param idx The index at which the element should be inserted.
  */
-template <typename T> void dsx::structs::vector<T>::insert_at(const T &elt, int idx) noexcept(false)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::insert_at(const T &elt, int idx) noexcept(false)
 {
     if (idx >= _len)
     {
@@ -383,7 +442,7 @@ template <typename T> void dsx::structs::vector<T>::insert_at(const T &elt, int
             // Double the capacity if the size is about to exceed the current
             // capacity
             _cap = (_cap == 0) ? 5 : _cap * 2;
-            T *new_arr = new T[_cap];
+            T *new_arr = allocate(_cap);
 
             std::copy(_arr, _arr + idx,
                       new_arr); // Copy elements before the insertion point
@@ -391,8 +450,10 @@ template <typename T> void dsx::structs::vector<T>::insert_at(const T &elt, int
             std::copy(_arr + idx, _arr + _len,
                       new_arr + idx + 1); // Copy remaining elements
 
-            delete[] _arr;  // Deallocate the memory used by the previous array
+            release(_arr);  // Deallocate the memory used by the previous array
             _arr = new_arr; // Update the pointer to the newly allocated array
+            _stats.on_growth();
+            _stats.on_copy(_len, sizeof(T));
 
             if (!_arr)
             {
@@ -412,9 +473,11 @@ template <typename T> void dsx::structs::vector<T>::insert_at(const T &elt, int
             }
 
             _arr[idx] = elt; // Insert the new element at the specified index
+            _stats.on_copy(_len - idx, sizeof(T));
 
             _len++; // Increment the length of the vector
         }
+        _stats.on_size(_len, _cap);
     }
 }
 
@@ -429,7 +492,7 @@ template <typename T> void dsx::structs::vector<T>::insert_at(const T &elt, int
  * @return An optional containing the removed element if the index is valid, or
  * an empty optional if the index is out of range.
  */
-template <typename T> std::optional<T> dsx::structs::vector<T>::erase_at(int idx)
+template <typename T, typename Stats> std::optional<T> dsx::structs::vector<T, Stats>::erase_at(int idx)
 {
     if (idx >= _len)
     {
@@ -443,6 +506,7 @@ template <typename T> std::optional<T> dsx::structs::vector<T>::erase_at(int idx
                            // specified index
 
     _len--; // Decrement the length of the vector
+    _stats.on_copy(_len - idx, sizeof(T));
 
     return erased_value; // Return the removed element
 }
@@ -457,11 +521,11 @@ template <typename T> std::optional<T> dsx::structs::vector<T>::erase_at(int idx
  * @throws std::runtime_error If memory reallocation fails while clearing the
  * vector.
  */
-template <typename T> void dsx::structs::vector<T>::clear() noexcept(false)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::clear() noexcept(false)
 {
-    T *n_arr = new T[_cap]; // Allocate memory for a new array with the initial
-                            // capacity
-    delete[] _arr;          // Deallocate the memory used by the previous array
+    T *n_arr = allocate(_cap); // Allocate memory for a new array with the initial
+                               // capacity
+    release(_arr);             // Deallocate the memory used by the previous array
     _arr = n_arr;           // Update the pointer to the newly allocated array
 
     if (!_arr)
@@ -481,23 +545,27 @@ template <typename T> void dsx::structs::vector<T>::clear() noexcept(false)
  * This function resizes the vector to the specified size. If the new size is
  * smaller than the current length, elements at the end of the vector are
  * removed. If the new size is larger than the current length, the vector's
- * capacity is adjusted to accommodate the new size efficiently.
+ * capacity is adjusted to accommodate the new size efficiently and the new
+ * elements are value-initialized.
  *
  * @param n_size The new size of the vector.
  * @throws std::runtime_error If memory reallocation fails while resizing the
  * vector.
  */
-template <typename T> void dsx::structs::vector<T>::resize(int n_size)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::resize(int n_size)
 {
     if (n_size < _len)
     {
         _len = n_size; // Reduce the vector's length if the new size is smaller
                        // than the current length
     }
-    else if (n_size > _len && n_size > _cap)
+    else if (n_size > _len)
     {
         reserve(n_size); // Increase the vector's capacity if the new size is
                          // larger than the current capacity
+        std::fill(_arr + _len, _arr + n_size, T{});
+        _len = n_size;
+        _stats.on_size(_len, _cap);
     }
 
     if (!_arr)
@@ -518,10 +586,11 @@ template <typename T> void dsx::structs::vector<T>::resize(int n_size)
  * @param o_vec The reference to the vector to be swapped with the current
  * vector.
  */
-template <typename T> void dsx::structs::vector<T>::swap(dsx::structs::vector<T> &o_vec)
+template <typename T, typename Stats> void dsx::structs::vector<T, Stats>::swap(dsx::structs::vector<T, Stats> &o_vec)
 {
     std::swap(this->_len, o_vec._len); // Swap the lengths
     std::swap(this->_arr,
               o_vec._arr);             // Swap the pointers to the underlying arrays
     std::swap(this->_cap, o_vec._cap); // Swap the capacities
+    std::swap(this->_stats, o_vec._stats); // The counters follow the buffers they describe
 }
@@ -0,0 +1,22 @@
+#include <flat_map/flat_map_test.hpp>
+#include <hash_map/map_test.hpp>
+#include <queue/channel_test.hpp>
+#include <vector/vec_test.hpp>
+
+int main()
+{
+    // Every suite exits with a message on the first failed assertion, so
+    // getting to the end means they all passed
+    int failed = 0;
+    failed |= vec_test();
+    failed |= incremental_vec_test();
+    failed |= concurrent_vec_test();
+    failed |= persistent_vec_test();
+    failed |= hash_map_test();
+    failed |= flat_map_test();
+    failed |= vec_stats_test();
+    failed |= bit_vector_test();
+    failed |= channel_test();
+
+    return failed;
+}